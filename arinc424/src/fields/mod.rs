@@ -18,12 +18,14 @@ use std::fmt;
 use std::str;
 
 mod arpt_heli_ident;
+mod arpt_heli_name;
 mod cont_nr;
 mod coordinate;
 mod cust_area;
 mod cycle;
 mod datum;
 mod fix_ident;
+mod fix_sec_sub_code;
 mod frn;
 mod iata;
 mod icao_code;
@@ -31,23 +33,31 @@ mod mag_true_ind;
 mod mag_var;
 mod name_desc;
 mod name_ind;
+mod path_term;
+mod proc_ident;
 mod record_type;
 mod regn_code;
+mod route_ident;
+mod route_type;
 mod runway_id;
 mod rwy_brg;
 mod rwy_grad;
 mod sec_sub_code;
+mod seq_nr;
 mod source;
+mod trans_ident;
 mod waypoint_type;
 mod waypoint_usage;
 
 pub use arpt_heli_ident::ArptHeliIdent;
+pub use arpt_heli_name::ArptHeliName;
 pub use cont_nr::ContNr;
 pub use coordinate::{CardinalDirection, Latitude, Longitude};
 pub use cust_area::CustArea;
 pub use cycle::Cycle;
 pub use datum::Datum;
 pub use fix_ident::FixIdent;
+pub use fix_sec_sub_code::FixSecSubCode;
 pub use frn::FileRecordNumber;
 pub use iata::Iata;
 pub use icao_code::IcaoCode;
@@ -55,13 +65,19 @@ pub use mag_true_ind::MagTrueInd;
 pub use mag_var::MagVar;
 pub use name_desc::NameDesc;
 pub use name_ind::NameInd;
+pub use path_term::PathTerm;
+pub use proc_ident::ProcIdent;
 pub use record_type::RecordType;
 pub use regn_code::RegnCode;
+pub use route_ident::RouteIdent;
+pub use route_type::RouteType;
 pub use runway_id::RunwayId;
 pub use rwy_brg::RwyBrg;
 pub use rwy_grad::RwyGrad;
 pub use sec_sub_code::{SecCode, SubCode};
+pub use seq_nr::SeqNr;
 pub use source::Source;
+pub use trans_ident::TransIdent;
 pub use waypoint_type::WaypointType;
 pub use waypoint_usage::WaypointUsage;
 
@@ -57,6 +57,7 @@ pub enum SubCode<const I: usize> {
     NDBNavaid,
     // Enroute
     Waypoint,
+    Airway,
     // Heliport,
     Pad,
     // Airport
@@ -65,6 +66,9 @@ pub enum SubCode<const I: usize> {
     Runway,
     // Heliport, Airport
     TerminalWaypoint,
+    SID,
+    STAR,
+    ApproachProcedure,
     MSA,
     // CompanyRoute
     CompanyRoute,
@@ -116,10 +120,26 @@ impl<const I: usize> FromStr for SubCode<I> {
                 SecCode::Airspace => Ok(Self::ControlledAirspace),
                 _ => sub_code_error!("C"),
             },
+            "D" => match sec_code {
+                SecCode::Heliport | SecCode::Airport => Ok(Self::SID),
+                _ => sub_code_error!("D"),
+            },
+            "E" => match sec_code {
+                SecCode::Heliport | SecCode::Airport => Ok(Self::STAR),
+                _ => sub_code_error!("E"),
+            },
+            "F" => match sec_code {
+                SecCode::Heliport | SecCode::Airport => Ok(Self::ApproachProcedure),
+                _ => sub_code_error!("F"),
+            },
             "G" => match sec_code {
                 SecCode::Airport => Ok(Self::Runway),
                 _ => sub_code_error!("G"),
             },
+            "R" => match sec_code {
+                SecCode::Enroute => Ok(Self::Airway),
+                _ => sub_code_error!("R"),
+            },
             "S" => match sec_code {
                 SecCode::MORA => Ok(Self::GridMORA),
                 SecCode::Heliport | SecCode::Airport => Ok(Self::MSA),
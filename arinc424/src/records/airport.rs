@@ -31,6 +31,7 @@ pub struct Airport {
     pub mag_var: MagVar<51, 32, 41>,
     pub mag_true_ind: MagTrueInd<85>,
     pub datum: Datum<86>,
+    pub arpt_name: ArptHeliName<93>,
     pub frn: FileRecordNumber,
     pub cycle: Cycle,
 }
@@ -53,6 +54,7 @@ impl FromStr for Airport {
             mag_var: s.parse()?,
             mag_true_ind: s.parse()?,
             datum: s.parse()?,
+            arpt_name: s.parse()?,
             frn: s.parse()?,
             cycle: s.parse()?,
         })
@@ -90,6 +92,7 @@ mod tests {
                 assert_eq!(wp.mag_var, MagVar::East(2, 0));
                 assert_eq!(wp.mag_true_ind, MagTrueInd::Magnetic);
                 assert_eq!(wp.datum, Datum::WGE);
+                assert_eq!(wp.arpt_name, "HAMBURG                       ");
                 assert_eq!(wp.frn, 35651);
                 assert_eq!(wp.cycle, Cycle { year: 24, cycle: 7 });
             }
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use crate::fields::*;
+use std::str::FromStr;
+
+/// An enroute airway record (`ER`) that describes one fix of an airway.
+///
+/// An airway is composed of all records with the same route identifier,
+/// ordered by their sequence number.
+pub struct Airway {
+    pub record_type: RecordType,
+    pub cust_area: CustArea,
+    pub sec_code: SecCode,
+    pub sub_code: SubCode<5>,
+    pub route_ident: RouteIdent<13>,
+    pub seq_nr: SeqNr<25, 4>,
+    pub fix_ident: FixIdent<29>,
+    pub icao_code: IcaoCode<34>,
+    pub fix_sec_sub_code: FixSecSubCode<36>,
+    pub cont_nr: ContNr<38>,
+    pub frn: FileRecordNumber,
+    pub cycle: Cycle,
+}
+
+impl FromStr for Airway {
+    type Err = FieldError;
+
+    fn from_str(s: &str) -> Result<Self, Self::Err> {
+        Ok(Self {
+            record_type: s.parse()?,
+            cust_area: s.parse()?,
+            sec_code: s.parse()?,
+            sub_code: s.parse()?,
+            route_ident: s.parse()?,
+            seq_nr: s.parse()?,
+            fix_ident: s.parse()?,
+            icao_code: s.parse()?,
+            fix_sec_sub_code: s.parse()?,
+            cont_nr: s.parse()?,
+            frn: s.parse()?,
+            cycle: s.parse()?,
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const ER_AIRWAY: &'static str = "SEURER       UL126       0010DHN  EDEA0     OH                                                                             123452509";
+
+    #[test]
+    fn airway_record() {
+        match Airway::from_str(ER_AIRWAY) {
+            Ok(awy) => {
+                assert_eq!(awy.record_type, RecordType::Standard);
+                assert_eq!(awy.cust_area, CustArea::EUR);
+                assert_eq!(awy.sec_code, SecCode::Enroute);
+                assert_eq!(awy.sub_code, SubCode::Airway);
+                assert_eq!(awy.route_ident, "UL126");
+                assert_eq!(awy.seq_nr, 10u32);
+                assert_eq!(awy.fix_ident, "DHN  ");
+                assert_eq!(awy.icao_code, "ED");
+                assert_eq!(awy.fix_sec_sub_code, "EA");
+                assert_eq!(awy.cont_nr, "0");
+                assert_eq!(awy.frn, 12345);
+                assert_eq!(awy.cycle, Cycle { year: 25, cycle: 9 });
+            }
+            Err(e) => panic!("Airway should be parsed. {:#?}", e),
+        }
+    }
+}
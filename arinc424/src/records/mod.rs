@@ -14,9 +14,13 @@
 // limitations under the License.
 
 mod airport;
+mod airway;
+mod procedure;
 mod runway;
 mod waypoint;
 
 pub use airport::Airport;
+pub use airway::Airway;
+pub use procedure::Procedure;
 pub use runway::Runway;
 pub use waypoint::Waypoint;
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use crate::fields::*;
+use std::str::FromStr;
+
+/// A SID (`PD`), STAR (`PE`) or approach procedure (`PF`) record that describes
+/// one leg of a procedure's transition.
+///
+/// All records with the same procedure identifier belong to one procedure. The
+/// records are grouped by the route type and transition identifier to the
+/// procedure's transitions and ordered by their sequence number.
+pub struct Procedure {
+    pub record_type: RecordType,
+    pub cust_area: CustArea,
+    pub sec_code: SecCode,
+    pub arpt_ident: ArptHeliIdent<6>,
+    pub icao_code: IcaoCode<10>,
+    pub sub_code: SubCode<12>,
+    pub proc_ident: ProcIdent<13>,
+    pub route_type: RouteType<19>,
+    pub trans_ident: TransIdent<20>,
+    pub seq_nr: SeqNr<26, 3>,
+    pub fix_ident: FixIdent<29>,
+    pub fix_icao_code: IcaoCode<34>,
+    pub fix_sec_sub_code: FixSecSubCode<36>,
+    pub cont_nr: ContNr<38>,
+    pub path_term: PathTerm<47>,
+    pub frn: FileRecordNumber,
+    pub cycle: Cycle,
+}
+
+impl FromStr for Procedure {
+    type Err = FieldError;
+
+    fn from_str(s: &str) -> Result<Self, Self::Err> {
+        Ok(Self {
+            record_type: s.parse()?,
+            cust_area: s.parse()?,
+            sec_code: s.parse()?,
+            arpt_ident: s.parse()?,
+            icao_code: s.parse()?,
+            sub_code: s.parse()?,
+            proc_ident: s.parse()?,
+            route_type: s.parse()?,
+            trans_ident: s.parse()?,
+            seq_nr: s.parse()?,
+            fix_ident: s.parse()?,
+            fix_icao_code: s.parse()?,
+            fix_sec_sub_code: s.parse()?,
+            cont_nr: s.parse()?,
+            path_term: s.parse()?,
+            frn: s.parse()?,
+            cycle: s.parse()?,
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const PD_SID: &'static str = "SEURP EDDHEDDABBE1D3ABBEN 020ABBENEDEA0        TF                                                                          000152509";
+
+    #[test]
+    fn sid_record() {
+        match Procedure::from_str(PD_SID) {
+            Ok(sid) => {
+                assert_eq!(sid.record_type, RecordType::Standard);
+                assert_eq!(sid.cust_area, CustArea::EUR);
+                assert_eq!(sid.sec_code, SecCode::Airport);
+                assert_eq!(sid.arpt_ident, "EDDH");
+                assert_eq!(sid.icao_code, "ED");
+                assert_eq!(sid.sub_code, SubCode::SID);
+                assert_eq!(sid.proc_ident, "ABBE1D");
+                assert_eq!(sid.route_type, "3");
+                assert_eq!(sid.trans_ident, "ABBEN");
+                assert_eq!(sid.seq_nr, 20u32);
+                assert_eq!(sid.fix_ident, "ABBEN");
+                assert_eq!(sid.fix_icao_code, "ED");
+                assert_eq!(sid.fix_sec_sub_code, "EA");
+                assert_eq!(sid.cont_nr, "0");
+                assert_eq!(sid.path_term, "TF");
+                assert_eq!(sid.frn, 15);
+                assert_eq!(sid.cycle, Cycle { year: 25, cycle: 9 });
+            }
+            Err(e) => panic!("Procedure should be parsed. {:#?}", e),
+        }
+    }
+}
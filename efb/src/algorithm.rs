@@ -55,6 +55,58 @@ pub fn winding_number(p: &Point, v: &[Point]) -> i32 {
     wn
 }
 
+/// Returns `true` if the line segments `a` and `b` intersect, including
+/// segments that touch each other.
+pub fn segments_intersect(a: (Point, Point), b: (Point, Point)) -> bool {
+    let (d1, d2) = (is_left_of_line(&b.0, &a), is_left_of_line(&b.1, &a));
+    let (d3, d4) = (is_left_of_line(&a.0, &b), is_left_of_line(&a.1, &b));
+
+    if d1 * d2 < 0.0 && d3 * d4 < 0.0 {
+        return true;
+    }
+
+    // collinear points that are on the other segment
+    let on_segment = |p: &Point, line: &Line| {
+        p.x >= line.0.x.min(line.1.x)
+            && p.x <= line.0.x.max(line.1.x)
+            && p.y >= line.0.y.min(line.1.y)
+            && p.y <= line.0.y.max(line.1.y)
+    };
+
+    (d1 == 0.0 && on_segment(&b.0, &a))
+        || (d2 == 0.0 && on_segment(&b.1, &a))
+        || (d3 == 0.0 && on_segment(&a.0, &b))
+        || (d4 == 0.0 && on_segment(&a.1, &b))
+}
+
+/// Returns the fraction along the segment `a` at which it crosses the segment
+/// `b`, or `None` if the segments don't cross or are parallel.
+pub fn segment_intersection(a: (Point, Point), b: (Point, Point)) -> Option<f32> {
+    let cross = |u: Point, v: Point| u.x * v.y - u.y * v.x;
+    let r = Point {
+        x: a.1.x - a.0.x,
+        y: a.1.y - a.0.y,
+    };
+    let s = Point {
+        x: b.1.x - b.0.x,
+        y: b.1.y - b.0.y,
+    };
+    let qp = Point {
+        x: b.0.x - a.0.x,
+        y: b.0.y - a.0.y,
+    };
+
+    let denom = cross(r, s);
+    if denom == 0.0 {
+        return None;
+    }
+
+    let t = cross(qp, s) / denom;
+    let u = cross(qp, r) / denom;
+
+    ((0.0..=1.0).contains(&t) && (0.0..=1.0).contains(&u)).then_some(t)
+}
+
 fn is_left_of_line(point: &Point, line: &Line) -> f32 {
     (line.1.x - line.0.x) * (point.y - line.0.y) - (point.x - line.0.x) * (line.1.y - line.0.y)
 }
@@ -77,6 +129,36 @@ mod tests {
         assert!(is_left_of_line(&point, &line) < 0.0);
     }
 
+    #[test]
+    fn segments_cross() {
+        let p = |x, y| Point { x, y };
+        assert!(segments_intersect(
+            (p(0.0, 0.0), p(10.0, 10.0)),
+            (p(0.0, 10.0), p(10.0, 0.0))
+        ));
+        assert!(segments_intersect(
+            (p(0.0, 0.0), p(10.0, 0.0)),
+            (p(10.0, 0.0), p(10.0, 10.0))
+        ));
+        assert!(!segments_intersect(
+            (p(0.0, 0.0), p(10.0, 0.0)),
+            (p(0.0, 1.0), p(10.0, 1.0))
+        ));
+    }
+
+    #[test]
+    fn fraction_of_intersection() {
+        let p = |x, y| Point { x, y };
+        assert_eq!(
+            segment_intersection((p(0.0, 0.0), p(10.0, 0.0)), (p(2.5, -1.0), p(2.5, 1.0))),
+            Some(0.25)
+        );
+        assert_eq!(
+            segment_intersection((p(0.0, 0.0), p(10.0, 0.0)), (p(0.0, 1.0), p(10.0, 1.0))),
+            None
+        );
+    }
+
     #[test]
     fn point_is_on_line() {
         let line = (Point { x: 10.0, y: 10.0 }, Point { x: 10.0, y: 20.0 });
@@ -13,17 +13,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-use std::fmt::{Display, Formatter, Result};
+use std::cell::{Cell, RefCell};
+use std::collections::HashMap;
+use std::fmt::{self, Display, Formatter};
+use std::rc::Rc;
 
 #[cfg(feature = "serde")]
 use serde::{Deserialize, Serialize};
 
-use time::OffsetDateTime;
+use time::{Date, OffsetDateTime};
 use world_magnetic_model::uom::si::{
     angle::degree, angle::radian, f32::Angle, f32::Length, length::meter,
 };
 use world_magnetic_model::GeomagneticField;
 
+use crate::error::Error;
 use crate::geom::Coordinate;
 
 /// The magnetic variation (declination) of a point.
@@ -41,18 +45,8 @@ pub enum MagneticVariation {
     OrientedToTrueNorth,
 }
 
-impl From<Coordinate> for MagneticVariation {
-    fn from(value: Coordinate) -> Self {
-        let mag_var = match GeomagneticField::new(
-            Length::new::<meter>(0.0),
-            Angle::new::<radian>(value.latitude.to_radians()),
-            Angle::new::<radian>(value.longitude.to_radians()),
-            OffsetDateTime::now_utc().date(),
-        ) {
-            Ok(field) => field.declination().get::<degree>(),
-            Err(_) => todo!("implement TryFrom to handle unavailable variation!"),
-        };
-
+impl MagneticVariation {
+    fn from_degrees(mag_var: f32) -> Self {
         if mag_var.is_sign_negative() {
             Self::West(mag_var.abs())
         } else {
@@ -61,8 +55,138 @@ impl From<Coordinate> for MagneticVariation {
     }
 }
 
+/// The declination at the coordinate for the current date.
+///
+/// The declination is interpolated from the [`DeclinationGrid`] of the
+/// current date. A point is oriented to true north if the World Magnetic
+/// Model doesn't cover the current date.
+impl From<Coordinate> for MagneticVariation {
+    fn from(value: Coordinate) -> Self {
+        DeclinationGrid::cached(OffsetDateTime::now_utc().date())
+            .declination(&value)
+            .unwrap_or(Self::OrientedToTrueNorth)
+    }
+}
+
+/// The number of grid nodes per degree of latitude and longitude.
+const NODES_PER_DEGREE: usize = 1;
+const LATITUDE_NODES: usize = 180 * NODES_PER_DEGREE + 1;
+const LONGITUDE_NODES: usize = 360 * NODES_PER_DEGREE + 1;
+
+/// The number of grids that are cached per thread.
+const CACHED_GRIDS: usize = 8;
+
+thread_local! {
+    static GRIDS: RefCell<HashMap<Date, Rc<DeclinationGrid>>> = RefCell::new(HashMap::new());
+}
+
+/// A grid of declinations of the World Magnetic Model at a fixed date.
+///
+/// Evaluating the model is costly, thus, the declination is evaluated at the
+/// nodes of a grid with 1° cells and interpolated bilinearly in between. The
+/// nodes are evaluated on first use, so only the cells that are used cost an
+/// evaluation. Since the date is fixed, the declinations are reproducible.
+///
+/// # Examples
+///
+/// ```
+/// # use efb::{coord, DeclinationGrid};
+/// # use efb::geom::Coordinate;
+/// # use time::{Date, Month};
+/// let grid = DeclinationGrid::new(Date::from_calendar_date(2025, Month::January, 1).unwrap());
+/// let mag_var = grid.declination(&coord!(53.63, 9.99))?;
+/// assert_eq!(mag_var, grid.declination(&coord!(53.63, 9.99))?);
+/// # Ok::<(), efb::error::Error>(())
+/// ```
+#[derive(Clone, Debug)]
+pub struct DeclinationGrid {
+    date: Date,
+    // the declination in degree of each node or NaN if not evaluated yet
+    nodes: Vec<Cell<f32>>,
+}
+
+impl DeclinationGrid {
+    /// Creates a grid of the declination at the `date`.
+    pub fn new(date: Date) -> Self {
+        Self {
+            date,
+            nodes: vec![Cell::new(f32::NAN); LATITUDE_NODES * LONGITUDE_NODES],
+        }
+    }
+
+    /// Returns the grid of the `date` that is shared within the thread.
+    pub(crate) fn cached(date: Date) -> Rc<Self> {
+        GRIDS.with_borrow_mut(|grids| {
+            if !grids.contains_key(&date) && grids.len() >= CACHED_GRIDS {
+                grids.clear();
+            }
+
+            Rc::clone(
+                grids
+                    .entry(date)
+                    .or_insert_with(|| Rc::new(Self::new(date))),
+            )
+        })
+    }
+
+    /// Returns the date of the declinations.
+    pub fn date(&self) -> Date {
+        self.date
+    }
+
+    /// Returns the declination at the `point` interpolated from the
+    /// surrounding nodes.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the World Magnetic Model doesn't cover the date of
+    /// the grid.
+    pub fn declination(&self, point: &Coordinate) -> Result<MagneticVariation, Error> {
+        let y = (point.latitude.clamp(-90.0, 90.0) + 90.0) * NODES_PER_DEGREE as f32;
+        let x = (point.longitude.clamp(-180.0, 180.0) + 180.0) * NODES_PER_DEGREE as f32;
+
+        // the last cell includes the upper boundary
+        let i = (y.floor() as usize).min(LATITUDE_NODES - 2);
+        let j = (x.floor() as usize).min(LONGITUDE_NODES - 2);
+        let (t, u) = (y - i as f32, x - j as f32);
+
+        let south = self.node(i, j)? * (1.0 - u) + self.node(i, j + 1)? * u;
+        let north = self.node(i + 1, j)? * (1.0 - u) + self.node(i + 1, j + 1)? * u;
+
+        Ok(MagneticVariation::from_degrees(
+            south * (1.0 - t) + north * t,
+        ))
+    }
+
+    /// Returns the declination at the node in the `i`-th row from the south
+    /// and `j`-th column from the west and evaluates it if needed.
+    fn node(&self, i: usize, j: usize) -> Result<f32, Error> {
+        let node = &self.nodes[i * LONGITUDE_NODES + j];
+        if node.get().is_nan() {
+            // the model is undefined at the poles
+            let latitude = (i as f32 / NODES_PER_DEGREE as f32 - 90.0).clamp(-89.99, 89.99);
+            let longitude = j as f32 / NODES_PER_DEGREE as f32 - 180.0;
+            node.set(evaluate(latitude, longitude, self.date)?);
+        }
+
+        Ok(node.get())
+    }
+}
+
+/// Evaluates the declination in degree of the World Magnetic Model.
+fn evaluate(latitude: f32, longitude: f32, date: Date) -> Result<f32, Error> {
+    GeomagneticField::new(
+        Length::new::<meter>(0.0),
+        Angle::new::<radian>(latitude.to_radians()),
+        Angle::new::<radian>(longitude.to_radians()),
+        date,
+    )
+    .map(|field| field.declination().get::<degree>())
+    .map_err(|_| Error::UnavailableDeclination)
+}
+
 impl Display for MagneticVariation {
-    fn fmt(&self, f: &mut Formatter<'_>) -> Result {
+    fn fmt(&self, f: &mut Formatter<'_>) -> fmt::Result {
         match self {
             Self::East(value) => write!(f, "{value:.1}° E"),
             Self::West(value) => write!(f, "{value:.1}° W"),
@@ -70,3 +194,65 @@ impl Display for MagneticVariation {
         }
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use time::Month;
+
+    use super::*;
+
+    fn date() -> Date {
+        Date::from_calendar_date(2025, Month::January, 1).expect("date should be valid")
+    }
+
+    fn degrees(mag_var: MagneticVariation) -> f32 {
+        match mag_var {
+            MagneticVariation::East(value) => value,
+            MagneticVariation::West(value) => -value,
+            MagneticVariation::OrientedToTrueNorth => 0.0,
+        }
+    }
+
+    fn declination(grid: &DeclinationGrid, point: Coordinate) -> f32 {
+        degrees(grid.declination(&point).expect("date should be covered"))
+    }
+
+    fn node(latitude: f32, longitude: f32, date: Date) -> f32 {
+        evaluate(latitude, longitude, date).expect("date should be covered")
+    }
+
+    #[test]
+    fn interpolates_between_nodes() {
+        let date = date();
+        let grid = DeclinationGrid::new(date);
+
+        let at_node = declination(&grid, coord!(53.0, 10.0));
+        assert!((at_node - node(53.0, 10.0, date)).abs() < 1e-5);
+
+        let between = declination(&grid, coord!(53.5, 10.5));
+        let expected = (node(53.0, 10.0, date)
+            + node(53.0, 11.0, date)
+            + node(54.0, 10.0, date)
+            + node(54.0, 11.0, date))
+            / 4.0;
+        assert!((between - expected).abs() < 1e-5);
+    }
+
+    #[test]
+    fn covers_boundaries() {
+        let grid = DeclinationGrid::new(date());
+        for point in [coord!(90.0, 180.0), coord!(-90.0, -180.0)] {
+            assert!(declination(&grid, point).is_finite());
+        }
+    }
+
+    #[test]
+    fn fails_outside_of_the_model() {
+        let date = Date::from_calendar_date(1990, Month::January, 1).expect("date should be valid");
+        let grid = DeclinationGrid::new(date);
+        assert_eq!(
+            grid.declination(&coord!(53.63, 9.99)),
+            Err(Error::UnavailableDeclination)
+        );
+    }
+}
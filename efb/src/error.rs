@@ -36,6 +36,18 @@ pub enum Error {
     UnexpectedRunwayInRoute(String),
     /// The route includes a runway that is not found on the associated airport.
     UnknownRunwayInRoute { aprt: String, rwy: String },
+    /// The route includes an airway on which the fix before or after the
+    /// airway is not located.
+    UnknownAirwaySegment {
+        airway: String,
+        from: String,
+        to: String,
+    },
+    /// The route includes a procedure without the requested transition.
+    UnknownTransition {
+        procedure: String,
+        transition: String,
+    },
 
     // Errors that are related to parsing of input data:
     //
@@ -46,6 +58,13 @@ pub enum Error {
     /// The location indicator should be a two-letter code according to ICAO
     /// Document No. 7910.
     UnknownLocationIndicator(String),
+    /// The line of a navigation data delta is malformed or of a section that
+    /// can't be updated by a delta.
+    UnexpectedDeltaRecord(String),
+    /// The line of an obstacle dataset is malformed.
+    UnexpectedObstacleRecord(String),
+    /// The bytes of a route's wire format are truncated or malformed.
+    UnexpectedWireFormat,
 
     // Errors that relate to navigation data:
     //
@@ -53,6 +72,13 @@ pub enum Error {
     UnknownIdent(String),
     /// The RWYCC should be between 0 and 6.
     InvalidRWYCC,
+    /// The content hash of the navigation data after applying a delta doesn't
+    /// match the hash of the delta.
+    DeltaHashMismatch { expected: u64, actual: u64 },
+    /// The bytes of a terrain tile are not a square of elevations.
+    UnexpectedTerrainTile,
+    /// The World Magnetic Model doesn't cover the date of a declination.
+    UnavailableDeclination,
 
     // Errors that originate from the mass & balance planning:
     //
@@ -91,6 +117,13 @@ impl fmt::Display for Error {
             Self::UnknownRunwayInRoute { aprt, rwy } => {
                 write!(f, "unknown runway {rwy} found for {aprt}")
             }
+            Self::UnknownAirwaySegment { airway, from, to } => {
+                write!(f, "airway {airway} should connect {from} and {to}")
+            }
+            Self::UnknownTransition {
+                procedure,
+                transition,
+            } => write!(f, "unknown transition {transition} found for {procedure}"),
 
             Self::UnexpectedString => write!(f, "unexpected string"),
             Self::ImplausibleValue => write!(f, "value seams implausuble"),
@@ -98,9 +131,22 @@ impl fmt::Display for Error {
                 f,
                 "location {code} should be according to ICAO document no. 7910"
             ),
+            Self::UnexpectedDeltaRecord(line) => write!(f, "unexpected delta record {line}"),
+            Self::UnexpectedObstacleRecord(line) => write!(f, "unexpected obstacle record {line}"),
+            Self::UnexpectedWireFormat => write!(f, "unexpected wire format"),
 
             Self::UnknownIdent(ident) => write!(f, "unknown ident {ident}"),
             Self::InvalidRWYCC => write!(f, "RWYCC should be between 0 and 6"),
+            Self::DeltaHashMismatch { expected, actual } => write!(
+                f,
+                "content hash {actual:016x} should match the delta's hash {expected:016x}"
+            ),
+            Self::UnexpectedTerrainTile => {
+                write!(f, "terrain tile should be a square of elevations")
+            }
+            Self::UnavailableDeclination => {
+                write!(f, "date should be covered by the World Magnetic Model")
+            }
 
             Self::UnexpectedMassesForStations => {
                 write!(f, "mass should match to aircraft's stations")
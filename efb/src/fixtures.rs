@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Fixtures shared by the unit tests.
+
+use crate::aircraft::{LoadedStation, Station};
+use crate::fp::{MassAndBalance, Performance, TakeoffLandingPerformance};
+use crate::measurements::{Length, Mass, Speed, Temperature, Volume};
+use crate::nd::NavigationData;
+use crate::route::Route;
+use crate::{Fuel, FuelFlow, FuelType, VerticalDistance};
+
+/// The airports EDDH and EDHF with a runway each and two waypoints in
+/// between.
+pub(crate) const ARINC_424_RECORDS: &str = r#"SEURP EDDHEDA        0        N N53374900E009591762E002000053                   P    MWGE    HAMBURG                       356462409
+SEURP EDDHEDGRW33    0120273330 N53374300E009595081                          151                                           124362502
+SEURPCEDDHED N1    ED0    V     N53482105E010015451                                 WGE           NOVEMBER1                359892409
+SEURPCEDDHED N2    ED0    V     N53405701E010000576                                 WGE           NOVEMBER2                359902409
+SEURP EDHFEDA        0        N N53593300E009343600E000000082                   P    MWGE    ITZEHOE/HUNGRIGER WOLF        320782409
+SEURP EDHFEDGRW20    0034122060 N53594752E009344856                          098                                           120792502
+"#;
+
+/// The airway UL126 going south-west from ABBEN via BASUM and CELLE to
+/// DELTA.
+pub(crate) const AIRWAY_RECORDS: &str = r#"SEUREAENRTED ABBEN ED0    C   B N53300000E009300000                                 WGE           ABBEN                    000012509
+SEUREAENRTED BASUM ED0    C   B N52500000E009000000                                 WGE           BASUM                    000022509
+SEUREAENRTED CELLE ED0    C   B N52300000E009200000                                 WGE           CELLE                    000032509
+SEUREAENRTED DELTA ED0    C   B N52000000E008400000                                 WGE           DELTA                    000042509
+SEURER       UL126       0010ABBENEDEA0     OH                                                                             000052509
+SEURER       UL126       0020BASUMEDEA0     OH                                                                             000062509
+SEURER       UL126       0030CELLEEDEA0     OH                                                                             000072509
+SEURER       UL126       0040DELTAEDEA0     OH                                                                             000082509
+"#;
+
+/// Returns the navigation data of the airports, waypoints and airway.
+pub(crate) fn nd() -> NavigationData {
+    let mut nd =
+        NavigationData::try_from_arinc424(ARINC_424_RECORDS).expect("records should be valid");
+    nd.append(NavigationData::try_from_arinc424(AIRWAY_RECORDS).expect("records should be valid"));
+    nd
+}
+
+/// Returns the route decoded from `s`.
+pub(crate) fn route(s: &str) -> Route {
+    let mut route = Route::new();
+    route.decode(s, &nd()).expect("route should decode");
+    route
+}
+
+/// Returns the performance of an aircraft that cruises at 107 kt burning 20 l
+/// of diesel per hour.
+pub(crate) fn performance() -> Performance {
+    Performance::from_fn(
+        |_| {
+            (
+                Speed::kt(107.0),
+                FuelFlow::PerHour(diesel!(Volume::l(20.0))),
+            )
+        },
+        VerticalDistance::Altitude(10000),
+    )
+}
+
+/// Returns the landing performance with the `ground_roll` in feet and twice
+/// that distance over a 50 ft obstacle.
+pub(crate) fn landing_performance(ground_roll: f32) -> TakeoffLandingPerformance {
+    TakeoffLandingPerformance::builder(vec![(
+        VerticalDistance::PressureAltitude(0),
+        Temperature::c(40.0),
+        Length::ft(ground_roll),
+        Length::ft(ground_roll * 2.0),
+    )])
+    .build()
+}
+
+/// Returns the mass & balance of an aircraft with 1000 kg on ramp and 950 kg
+/// after landing.
+pub(crate) fn mass_and_balance() -> MassAndBalance {
+    MassAndBalance::new(&vec![LoadedStation {
+        station: Station::new(Length::m(1.0), None),
+        on_ramp: Mass::kg(1000.0),
+        after_landing: Mass::kg(950.0),
+    }])
+}
@@ -21,10 +21,13 @@
 //! modify e.g. the navigation data and takes care that the route is reevaluated
 //! based on the new data.
 
+use std::io;
+
 use crate::error::{Error, Result};
 use crate::fp::{FlightPlanning, FlightPlanningBuilder};
+use crate::gnss::Position;
 use crate::nd::NavigationData;
-use crate::route::Route;
+use crate::route::{Route, Tracker};
 
 mod printer;
 pub use printer::*;
@@ -44,6 +47,7 @@ pub struct FMS {
     context: Context,
     route: Route,
     flight_planning: Option<FlightPlanning>,
+    tracker: Option<Tracker>,
 }
 
 impl FMS {
@@ -124,13 +128,63 @@ impl FMS {
         self.flight_planning.as_ref()
     }
 
+    /// Updates the in-flight tracking of the route with the `position`, e.g.
+    /// of a [`NmeaReader`].
+    ///
+    /// The tracking starts with the first update. Returns `true` if a leg was
+    /// sequenced by the update.
+    ///
+    /// [`NmeaReader`]: crate::gnss::NmeaReader
+    pub fn update_position(&mut self, position: &Position) -> bool {
+        self.tracker
+            .get_or_insert_with(|| Tracker::new(&self.route))
+            .update(&position.coordinate, position.gs, position.time)
+    }
+
+    /// Returns the in-flight tracking of the route once a position was
+    /// updated.
+    pub fn tracker(&self) -> Option<&Tracker> {
+        self.tracker.as_ref()
+    }
+
     /// Prints the route and planning with a defined line length.
+    ///
+    /// # Panics
+    ///
+    /// Panics if a value can't be formatted, which [`try_print`] returns as
+    /// error instead.
+    ///
+    /// [`try_print`]: FMS::try_print
     pub fn print(&self, line_length: usize) -> String {
-        let printer = Printer { line_length };
-        // TODO: Add print errors and return Result.
-        printer
-            .print(&self.route, self.flight_planning.as_ref())
-            .unwrap_or_default()
+        self.try_print(line_length)
+            .expect("printing to a string should succeed")
+    }
+
+    /// Prints the route and planning with a defined line length or returns
+    /// the error of a value that can't be formatted.
+    pub fn try_print(&self, line_length: usize) -> std::result::Result<String, std::fmt::Error> {
+        Printer { line_length }.print(&self.route, self.flight_planning.as_ref())
+    }
+
+    /// Writes the route and planning with a defined line length to the
+    /// `writer`, e.g. a file, without building the output first.
+    pub fn print_to<W: io::Write>(&self, writer: &mut W, line_length: usize) -> io::Result<()> {
+        Printer { line_length }.write_io(writer, &self.route, self.flight_planning.as_ref())
+    }
+
+    /// Writes the navigation log of the route in the `format` to the
+    /// `writer`.
+    ///
+    /// The line length applies only to the [fixed width] format.
+    ///
+    /// [fixed width]: NavlogFormat::FixedWidth
+    pub fn print_navlog<W: io::Write>(
+        &self,
+        writer: &mut W,
+        line_length: usize,
+        format: NavlogFormat,
+    ) -> io::Result<()> {
+        Printer { line_length }.write_navlog_io(writer, &self.route, format)
     }
 
     fn reevaluate(&mut self) -> Result<()> {
@@ -143,6 +197,11 @@ impl FMS {
             self.flight_planning = Some(flight_planning);
         }
 
+        // keep the active leg of a route that is modified in flight
+        if let Some(tracker) = &self.tracker {
+            self.tracker = Some(tracker.rebuild(&self.route));
+        }
+
         Ok(())
     }
 }
@@ -13,18 +13,39 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-use std::fmt::{Error, Write as _};
+use std::fmt::{Error, Write};
+use std::io;
 
 use crate::fp::{FlightPlanning, FuelPlanning, RunwayAnalysis};
-use crate::measurements::LengthUnit;
+use crate::measurements::{Duration, LengthUnit};
 use crate::nd::*;
 use crate::route::Route;
 
+/// The format of a navigation log.
+#[repr(C)]
+#[derive(Copy, Clone, Eq, PartialEq, Hash, Debug)]
+pub enum NavlogFormat {
+    /// Columns of fixed width that fit into the line length, e.g. to be
+    /// printed for a kneeboard.
+    FixedWidth,
+    /// Comma-separated values with a header.
+    Csv,
+    /// A JSON array with an object per leg.
+    Json,
+}
+
 /// Prints the flight planning of the FMS.
 ///
 /// The printer can [`print`] the route and if available the fuel and mass & balance
 /// of the FMS to a String with a defined line length. The result can be used to
 /// print it to a physical sheet of paper as a hard copy of the planning.
+///
+/// The output can also be streamed to any [`fmt::Write`] or [`io::Write`]
+/// sink without building the whole output first. A navigation log with a
+/// row per leg is written in the [`NavlogFormat`], e.g. as CSV.
+///
+/// [`print`]: Printer::print
+/// [`fmt::Write`]: std::fmt::Write
 #[derive(Copy, Clone, Eq, PartialEq, Hash, Debug, Default)]
 pub struct Printer {
     /// The line length of the printers output.
@@ -32,6 +53,11 @@ pub struct Printer {
 }
 
 impl Printer {
+    /// Creates a printer with the `line_length`.
+    pub fn new(line_length: usize) -> Self {
+        Self { line_length }
+    }
+
     /// Prints the flight planning of the FMS.
     pub fn print(
         &self,
@@ -39,39 +65,153 @@ impl Printer {
         flight_planning: Option<&FlightPlanning>,
     ) -> Result<String, Error> {
         let mut buffer = String::new();
+        self.write(&mut buffer, route, flight_planning)?;
+        Ok(buffer)
+    }
 
-        self.write_route(&mut buffer, route)?;
+    /// Writes the flight planning of the FMS to the `buffer`.
+    pub fn write<W: Write>(
+        &self,
+        buffer: &mut W,
+        route: &Route,
+        flight_planning: Option<&FlightPlanning>,
+    ) -> Result<(), Error> {
+        self.write_route(buffer, route)?;
 
         if let Some(flight_planning) = flight_planning {
             if let Some(fuel_planning) = flight_planning.fuel_planning() {
-                self.write_fuel(&mut buffer, fuel_planning)?;
+                self.write_fuel(buffer, fuel_planning)?;
             }
 
-            self.write_mb(&mut buffer, flight_planning)?;
+            self.write_mb(buffer, flight_planning)?;
 
             if let Some(rwy_analysis) = flight_planning.takeoff_rwy_analysis() {
-                self.write_takeoff_landing_rwy_analysis(&mut buffer, "TAKEOFF RWY", rwy_analysis)?;
+                self.write_takeoff_landing_rwy_analysis(buffer, "TAKEOFF RWY", rwy_analysis)?;
             }
 
             if let Some(rwy_analysis) = flight_planning.landing_rwy_analysis() {
-                self.write_takeoff_landing_rwy_analysis(&mut buffer, "LANDING RWY", rwy_analysis)?;
+                self.write_takeoff_landing_rwy_analysis(buffer, "LANDING RWY", rwy_analysis)?;
             }
         }
 
-        Ok(buffer)
+        Ok(())
+    }
+
+    /// Writes the flight planning of the FMS to the `writer`, e.g. a file.
+    pub fn write_io<W: io::Write>(
+        &self,
+        writer: &mut W,
+        route: &Route,
+        flight_planning: Option<&FlightPlanning>,
+    ) -> io::Result<()> {
+        IoWriter::adapt(writer, |buffer| self.write(buffer, route, flight_planning))
+    }
+
+    /// Writes the navigation log of the `route` with a row per leg in the
+    /// `format` to the `buffer`.
+    ///
+    /// Each row has the ident of the leg's end, the magnetic heading or
+    /// course, the distance and estimated time enroute of the leg and the
+    /// accumulated distance and time. Distances are in nautical miles and
+    /// times in minutes or for the fixed width `HH:MM`.
+    pub fn write_navlog<W: Write>(
+        &self,
+        buffer: &mut W,
+        route: &Route,
+        format: NavlogFormat,
+    ) -> Result<(), Error> {
+        match format {
+            NavlogFormat::FixedWidth => {
+                let space = self.line_length.saturating_sub(NAVLOG_WIDTH) / 5;
+                writeln!(
+                    buffer,
+                    "{:<6}{:space$}{:>3}{:space$}{:>6}{:space$}{:>5}{:space$}{:>6}{:space$}{:>5}",
+                    "TO", "", "HDG", "", "DIST", "", "ETE", "", "TOTAL", "", "TTE"
+                )?;
+            }
+            NavlogFormat::Csv => writeln!(buffer, "to,heading,dist,ete,total_dist,total_ete")?,
+            NavlogFormat::Json => write!(buffer, "[")?,
+        }
+
+        for (i, (leg, totals)) in route
+            .legs()
+            .iter()
+            .zip(route.accumulate_legs(None))
+            .enumerate()
+        {
+            let heading = *leg.mh().unwrap_or(leg.mc()).value();
+            let dist = *leg.dist().convert_to(LengthUnit::NauticalMiles).value();
+            let total_dist = *totals.dist().convert_to(LengthUnit::NauticalMiles).value();
+            let ident = leg.to().ident();
+
+            match format {
+                NavlogFormat::FixedWidth => {
+                    let space = self.line_length.saturating_sub(NAVLOG_WIDTH) / 5;
+                    write!(
+                        buffer,
+                        "{ident:<6}{:space$}{heading:03.0}{:space$}{dist:>6.1}{:space$}",
+                        "", "", ""
+                    )?;
+                    write_hhmm(buffer, leg.ete())?;
+                    write!(buffer, "{:space$}{total_dist:>6.1}{:space$}", "", "")?;
+                    write_hhmm(buffer, totals.ete())?;
+                    writeln!(buffer)?;
+                }
+                NavlogFormat::Csv => {
+                    write_csv_str(buffer, &ident)?;
+                    write!(buffer, ",{heading:.0},{dist:.1},")?;
+                    write_minutes(buffer, leg.ete())?;
+                    write!(buffer, ",{total_dist:.1},")?;
+                    write_minutes(buffer, totals.ete())?;
+                    writeln!(buffer)?;
+                }
+                NavlogFormat::Json => {
+                    if i > 0 {
+                        write!(buffer, ",")?;
+                    }
+                    write!(buffer, "{{\"to\":")?;
+                    write_json_str(buffer, &ident)?;
+                    write!(
+                        buffer,
+                        ",\"heading\":{heading:.0},\"dist\":{dist:.1},\"ete\":"
+                    )?;
+                    write_json_minutes(buffer, leg.ete())?;
+                    write!(buffer, ",\"total_dist\":{total_dist:.1},\"total_ete\":")?;
+                    write_json_minutes(buffer, totals.ete())?;
+                    write!(buffer, "}}")?;
+                }
+            }
+        }
+
+        if format == NavlogFormat::Json {
+            writeln!(buffer, "]")?;
+        }
+
+        Ok(())
+    }
+
+    /// Writes the navigation log of the `route` in the `format` to the
+    /// `writer`, e.g. a file.
+    pub fn write_navlog_io<W: io::Write>(
+        &self,
+        writer: &mut W,
+        route: &Route,
+        format: NavlogFormat,
+    ) -> io::Result<()> {
+        IoWriter::adapt(writer, |buffer| self.write_navlog(buffer, route, format))
     }
 
     /// Writes a section with title to the buffer.
-    fn write_section(&self, buffer: &mut String, title: &str) -> Result<(), Error> {
-        writeln!(buffer, "{}", "-".repeat(self.line_length))?;
+    fn write_section<W: Write>(&self, buffer: &mut W, title: &str) -> Result<(), Error> {
+        writeln!(buffer, "{:-<1$}", "", self.line_length)?;
         writeln!(buffer, "-- {title}")?;
-        writeln!(buffer, "{}", "-".repeat(self.line_length))?;
+        writeln!(buffer, "{:-<1$}", "", self.line_length)?;
         writeln!(buffer)?;
         Ok(())
     }
 
     /// Writes the route to the buffer.
-    fn write_route(&self, buffer: &mut String, route: &Route) -> Result<(), Error> {
+    fn write_route<W: Write>(&self, buffer: &mut W, route: &Route) -> Result<(), Error> {
         self.write_section(buffer, "ROUTE")?;
 
         for leg in route.legs() {
@@ -120,7 +260,11 @@ impl Printer {
     }
 
     /// Writes the fuel planning to the buffer.
-    fn write_fuel(&self, buffer: &mut String, fuel_planning: &FuelPlanning) -> Result<(), Error> {
+    fn write_fuel<W: Write>(
+        &self,
+        buffer: &mut W,
+        fuel_planning: &FuelPlanning,
+    ) -> Result<(), Error> {
         self.write_section(buffer, "FUEL")?;
 
         writeln!(
@@ -177,7 +321,11 @@ impl Printer {
     }
 
     /// Writes the mass & balance of the flight planning to the buffer.
-    fn write_mb(&self, buffer: &mut String, flight_planning: &FlightPlanning) -> Result<(), Error> {
+    fn write_mb<W: Write>(
+        &self,
+        buffer: &mut W,
+        flight_planning: &FlightPlanning,
+    ) -> Result<(), Error> {
         self.write_section(buffer, "MASS & BALANCE")?;
 
         if let Some(mb) = flight_planning.mb() {
@@ -215,9 +363,9 @@ impl Printer {
         Ok(())
     }
 
-    fn write_takeoff_landing_rwy_analysis(
+    fn write_takeoff_landing_rwy_analysis<W: Write>(
         &self,
-        buffer: &mut String,
+        buffer: &mut W,
         section: &str,
         rwy_analysis: &RunwayAnalysis,
     ) -> Result<(), Error> {
@@ -263,3 +411,181 @@ impl Printer {
         Ok(())
     }
 }
+
+/// The width of the navigation log's columns without the space in between.
+const NAVLOG_WIDTH: usize = 6 + 3 + 6 + 5 + 6 + 5;
+
+fn write_hhmm<W: Write>(buffer: &mut W, ete: Option<&Duration>) -> Result<(), Error> {
+    match ete.map(Duration::round) {
+        Some(ete) => write!(buffer, "{:02}:{:02}", ete.hours(), ete.minutes()),
+        None => write!(buffer, "{:>5}", "-"),
+    }
+}
+
+fn write_minutes<W: Write>(buffer: &mut W, ete: Option<&Duration>) -> Result<(), Error> {
+    match ete {
+        Some(ete) => write!(buffer, "{}", ete.round().value() / 60),
+        None => Ok(()),
+    }
+}
+
+fn write_json_minutes<W: Write>(buffer: &mut W, ete: Option<&Duration>) -> Result<(), Error> {
+    match ete {
+        Some(_) => write_minutes(buffer, ete),
+        None => write!(buffer, "null"),
+    }
+}
+
+/// Writes the string `s` as CSV field which is quoted if needed.
+fn write_csv_str<W: Write>(buffer: &mut W, s: &str) -> Result<(), Error> {
+    if !s.contains([',', '"', '\n']) {
+        return buffer.write_str(s);
+    }
+
+    buffer.write_char('"')?;
+    for c in s.chars() {
+        if c == '"' {
+            buffer.write_char('"')?;
+        }
+        buffer.write_char(c)?;
+    }
+    buffer.write_char('"')
+}
+
+/// Writes the string `s` as JSON string.
+fn write_json_str<W: Write>(buffer: &mut W, s: &str) -> Result<(), Error> {
+    buffer.write_char('"')?;
+    for c in s.chars() {
+        match c {
+            '"' => buffer.write_str("\\\"")?,
+            '\\' => buffer.write_str("\\\\")?,
+            c if c.is_control() => write!(buffer, "\\u{:04x}", c as u32)?,
+            c => buffer.write_char(c)?,
+        }
+    }
+    buffer.write_char('"')
+}
+
+/// Writes formatted output to an [`io::Write`] and keeps the I/O error that
+/// a [`fmt::Error`] can't carry.
+///
+/// The many small fragments of a row are buffered, so the writer isn't
+/// called for each of them.
+///
+/// [`fmt::Error`]: std::fmt::Error
+struct IoWriter<'a, W: io::Write> {
+    inner: io::BufWriter<&'a mut W>,
+    error: io::Result<()>,
+}
+
+impl<'a, W: io::Write> IoWriter<'a, W> {
+    /// Calls `f` with a buffer that writes to the `writer`.
+    fn adapt(writer: &'a mut W, f: impl FnOnce(&mut Self) -> Result<(), Error>) -> io::Result<()> {
+        let mut buffer = Self {
+            inner: io::BufWriter::new(writer),
+            error: Ok(()),
+        };
+
+        match f(&mut buffer) {
+            Ok(()) => io::Write::flush(&mut buffer.inner),
+            Err(_) => buffer.error.and(Err(io::Error::other("formatting failed"))),
+        }
+    }
+}
+
+impl<W: io::Write> Write for IoWriter<'_, W> {
+    fn write_str(&mut self, s: &str) -> Result<(), Error> {
+        io::Write::write_all(&mut self.inner, s.as_bytes()).map_err(|e| {
+            self.error = Err(e);
+            Error
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn escapes_strings() {
+        let mut buffer = String::new();
+        write_json_str(&mut buffer, "A\"B\\").expect("writing to a string should succeed");
+        write_csv_str(&mut buffer, "A,\"B\"").expect("writing to a string should succeed");
+        assert_eq!(buffer, r#""A\"B\\""A,""B""""#);
+    }
+
+    #[test]
+    fn writes_navlog() {
+        let nd = NavigationData::try_from_arinc424(
+            r#"SEURPCEDDHED N1    ED0    V     N53482105E010015451                                 WGE           NOVEMBER1                359892409
+SEURPCEDDHED N2    ED0    V     N53405701E010000576                                 WGE           NOVEMBER2                359902409"#,
+        )
+        .expect("records should be valid");
+        let mut route = Route::new();
+        route.decode("DHN2 DHN1", &nd).expect("route should decode");
+
+        let navlog = |format| {
+            let mut buffer = String::new();
+            Printer::new(40)
+                .write_navlog(&mut buffer, &route, format)
+                .expect("writing to a string should succeed");
+            buffer
+        };
+
+        let csv = navlog(NavlogFormat::Csv);
+        let mut rows = csv.lines();
+        assert_eq!(
+            rows.next(),
+            Some("to,heading,dist,ete,total_dist,total_ete")
+        );
+        assert!(rows
+            .next()
+            .is_some_and(|row| row.starts_with("DHN1,") && row.split(',').count() == 6));
+        assert_eq!(rows.next(), None);
+
+        let json = navlog(NavlogFormat::Json);
+        assert!(json.starts_with(r#"[{"to":"DHN1","heading":"#));
+        assert!(json.ends_with("\"total_ete\":null}]\n"));
+
+        let fixed_width = navlog(NavlogFormat::FixedWidth);
+        assert!(fixed_width.lines().all(|line| line.len() <= 40));
+        assert_eq!(fixed_width.lines().count(), 2);
+    }
+
+    #[test]
+    fn streams_to_io() {
+        let mut sink = Vec::new();
+        Printer::new(40)
+            .write_io(&mut sink, &Route::new(), None)
+            .expect("writing to a vector should succeed");
+
+        assert_eq!(
+            String::from_utf8(sink).expect("output should be UTF-8"),
+            Printer::new(40)
+                .print(&Route::new(), None)
+                .expect("printing should succeed")
+        );
+    }
+
+    #[test]
+    fn buffers_fragments() {
+        struct Counter(usize);
+
+        impl io::Write for Counter {
+            fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+                self.0 += 1;
+                Ok(buf.len())
+            }
+
+            fn flush(&mut self) -> io::Result<()> {
+                Ok(())
+            }
+        }
+
+        let mut counter = Counter(0);
+        Printer::new(40)
+            .write_io(&mut counter, &Route::new(), None)
+            .expect("writing should succeed");
+        assert_eq!(counter.0, 1);
+    }
+}
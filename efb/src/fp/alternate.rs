@@ -0,0 +1,349 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::rc::Rc;
+use std::thread;
+
+use super::{
+    AlteringFactors, MassAndBalance, Performance, RunwayAnalysis, TakeoffLandingPerformance,
+};
+use crate::measurements::{Length, Speed, Temperature};
+use crate::nd::{Airport, Fix, NavAid, NavigationData, Runway, RunwayConditionCode};
+use crate::route::{Leg, Route};
+use crate::{Fuel, Wind};
+
+/// The number of candidates below which a thread isn't worth spawning.
+const CANDIDATES_PER_THREAD: usize = 16;
+
+/// An alternate airport with its most suitable runway.
+#[derive(Clone, PartialEq, Debug)]
+pub struct Alternate {
+    airport: Rc<Airport>,
+    rwy: Runway,
+    analysis: RunwayAnalysis,
+    leg: Leg,
+    fuel: Option<Fuel>,
+}
+
+/// Finder of alternate airports near the destination of a route.
+///
+/// The finder searches the airports within a radius around the destination
+/// and analyses their runways for landing with the planned mass after landing.
+/// An airport is a candidate if the landing ground roll of a runway leaves
+/// a margin and, if set, the crosswind is within the limit. The candidates
+/// are ranked by the alternate fuel, which is computed for the final leg of
+/// the route diverted to the airport, as in [`Route::alternate`].
+///
+/// The runway analyses of many candidates are computed in parallel.
+///
+/// # Examples
+///
+/// ```
+/// # use efb::fp::{AlternateFinder, MassAndBalance, Performance, TakeoffLandingPerformance};
+/// # use efb::measurements::Length;
+/// # use efb::nd::Fix;
+/// # use efb::prelude::FMS;
+/// # use efb::error::Error;
+/// # fn find(fms: &mut FMS, perf: &Performance, landing_perf: &TakeoffLandingPerformance, mb: &MassAndBalance) -> Result<(), Error> {
+/// let alternates = AlternateFinder::new(perf, landing_perf, mb)
+///     .radius(Length::nm(40.0))
+///     .find(fms.nd(), fms.route());
+///
+/// if let Some(ident) = alternates.first().map(|alternate| alternate.airport().ident()) {
+///     fms.set_alternate(&ident)?;
+/// }
+/// # Ok(())
+/// # }
+/// ```
+#[derive(Clone, Debug)]
+pub struct AlternateFinder<'a> {
+    perf: &'a Performance,
+    landing_perf: &'a TakeoffLandingPerformance,
+    mb: &'a MassAndBalance,
+    factors: Option<&'a AlteringFactors>,
+    radius: Length,
+    rwycc: RunwayConditionCode,
+    wind: Wind,
+    temperature: Temperature,
+    max_crosswind: Option<Speed>,
+}
+
+impl<'a> AlternateFinder<'a> {
+    /// Creates a finder with the cruise `perf`, the `landing_perf` and the
+    /// planned `mb`.
+    ///
+    /// By default, airports within 50 NM are searched and their runways are
+    /// analysed dry, with calm wind and at 15°C.
+    pub fn new(
+        perf: &'a Performance,
+        landing_perf: &'a TakeoffLandingPerformance,
+        mb: &'a MassAndBalance,
+    ) -> Self {
+        Self {
+            perf,
+            landing_perf,
+            mb,
+            factors: None,
+            radius: Length::nm(50.0),
+            rwycc: RunwayConditionCode::Six,
+            wind: Wind::default(),
+            temperature: Temperature::c(15.0),
+            max_crosswind: None,
+        }
+    }
+
+    /// Sets the radius around the destination within which alternates are
+    /// searched.
+    pub fn radius(&mut self, radius: Length) -> &mut Self {
+        self.radius = radius;
+        self
+    }
+
+    /// Sets the runway condition code, wind and temperature expected at the
+    /// alternates.
+    pub fn conditions(
+        &mut self,
+        rwycc: RunwayConditionCode,
+        wind: Wind,
+        temperature: Temperature,
+    ) -> &mut Self {
+        self.rwycc = rwycc;
+        self.wind = wind;
+        self.temperature = temperature;
+        self
+    }
+
+    /// Sets the factors that alter the landing distances.
+    pub fn factors(&mut self, factors: &'a AlteringFactors) -> &mut Self {
+        self.factors = Some(factors);
+        self
+    }
+
+    /// Sets the maximum crosswind component of a runway.
+    pub fn max_crosswind(&mut self, crosswind: Speed) -> &mut Self {
+        self.max_crosswind = Some(crosswind);
+        self
+    }
+
+    /// Returns the alternates of the `route`'s destination ranked by their
+    /// alternate fuel and distance.
+    ///
+    /// No alternates are returned if the route has no destination airport.
+    pub fn find(&self, nd: &NavigationData, route: &Route) -> Vec<Alternate> {
+        let (Some(destination), Some(final_leg)) = (route.destination(), route.legs().last())
+        else {
+            return Vec::new();
+        };
+
+        let airports: Vec<Rc<Airport>> = nd
+            .airports_within(&destination.coordinate(), self.radius)
+            .into_iter()
+            .map(|(_, airport)| airport)
+            .filter(|airport| airport.icao_ident != destination.icao_ident)
+            .collect();
+
+        let runways: Vec<&[Runway]> = airports
+            .iter()
+            .map(|aprt| aprt.runways.as_slice())
+            .collect();
+        let analyses = self.analyse(&runways);
+
+        let mut alternates: Vec<Alternate> = airports
+            .iter()
+            .zip(analyses)
+            .filter_map(|(airport, best)| {
+                let (i, analysis) = best?;
+                let leg = Leg::new(
+                    final_leg.from().clone(),
+                    NavAid::Airport(Rc::clone(airport)),
+                    final_leg.level().copied(),
+                    final_leg.tas().copied(),
+                    final_leg.wind().copied(),
+                );
+
+                Some(Alternate {
+                    airport: Rc::clone(airport),
+                    rwy: airport.runways[i].clone(),
+                    analysis,
+                    fuel: leg.fuel(self.perf),
+                    leg,
+                })
+            })
+            .collect();
+
+        alternates.sort_by(|a, b| {
+            let fuel =
+                |alternate: &Alternate| alternate.fuel.map_or(f32::INFINITY, |f| f.mass.to_si());
+            fuel(a)
+                .total_cmp(&fuel(b))
+                .then(a.leg.dist().to_si().total_cmp(&b.leg.dist().to_si()))
+        });
+
+        alternates
+    }
+
+    /// Returns the index and analysis of the runway with the largest margin of
+    /// each airport's `runways`, or `None` if no runway is suitable.
+    ///
+    /// The airports are split into chunks that are analysed in parallel.
+    fn analyse(&self, runways: &[&[Runway]]) -> Vec<Option<(usize, RunwayAnalysis)>> {
+        let threads = thread::available_parallelism().map_or(1, |n| n.get());
+        let chunk = runways.len().div_ceil(threads).max(CANDIDATES_PER_THREAD);
+
+        if runways.len() <= chunk {
+            return runways.iter().map(|rwys| self.best(rwys)).collect();
+        }
+
+        thread::scope(|scope| {
+            let handles: Vec<_> = runways
+                .chunks(chunk)
+                .map(|chunk| {
+                    scope
+                        .spawn(move || chunk.iter().map(|rwys| self.best(rwys)).collect::<Vec<_>>())
+                })
+                .collect();
+
+            handles
+                .into_iter()
+                .flat_map(|handle| handle.join().expect("runway analysis shouldn't panic"))
+                .collect()
+        })
+    }
+
+    fn best(&self, runways: &[Runway]) -> Option<(usize, RunwayAnalysis)> {
+        runways
+            .iter()
+            .map(|rwy| {
+                RunwayAnalysis::landing(
+                    rwy,
+                    self.rwycc,
+                    &self.wind,
+                    self.temperature,
+                    self.mb,
+                    self.landing_perf,
+                    self.factors,
+                )
+            })
+            .enumerate()
+            .filter(|(_, analysis)| analysis.margin().to_si() >= 0.0)
+            .filter(|(_, analysis)| {
+                self.max_crosswind
+                    .is_none_or(|max| analysis.crosswind().to_si().abs() <= max.to_si())
+            })
+            .max_by(|(_, a), (_, b)| a.margin().to_si().total_cmp(&b.margin().to_si()))
+    }
+}
+
+impl Alternate {
+    /// The alternate airport.
+    pub fn airport(&self) -> &Rc<Airport> {
+        &self.airport
+    }
+
+    /// The runway with the largest landing margin.
+    pub fn rwy(&self) -> &Runway {
+        &self.rwy
+    }
+
+    /// The landing analysis of the runway.
+    pub fn analysis(&self) -> &RunwayAnalysis {
+        &self.analysis
+    }
+
+    /// The final leg of the route diverted to the alternate.
+    pub fn leg(&self) -> &Leg {
+        &self.leg
+    }
+
+    /// The alternate fuel if the level and ETE of the leg are known.
+    pub fn fuel(&self) -> Option<&Fuel> {
+        self.fuel.as_ref()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::fixtures;
+    use crate::measurements::Angle;
+    use crate::nd::RunwaySurface;
+    use crate::VerticalDistance;
+
+    fn rwy(lda: f32) -> Runway {
+        Runway {
+            designator: String::from("27"),
+            bearing: Angle::t(270.0),
+            length: Length::ft(lda),
+            tora: Length::ft(lda),
+            toda: Length::ft(lda),
+            lda: Length::ft(lda),
+            surface: RunwaySurface::Asphalt,
+            slope: 0.0,
+            elev: VerticalDistance::Gnd,
+        }
+    }
+
+    #[test]
+    fn analyses_candidates_in_parallel() {
+        let perf = fixtures::performance();
+        let landing_perf = fixtures::landing_performance(1000.0);
+        let mb = fixtures::mass_and_balance();
+
+        // every other airport has a runway that is too short
+        let runways: Vec<Vec<Runway>> = (0..200)
+            .map(|i| vec![rwy(800.0), rwy(if i % 2 == 0 { 3000.0 } else { 900.0 })])
+            .collect();
+        let slices: Vec<&[Runway]> = runways.iter().map(Vec::as_slice).collect();
+
+        let analyses = AlternateFinder::new(&perf, &landing_perf, &mb).analyse(&slices);
+        assert_eq!(analyses.len(), 200);
+        for (i, best) in analyses.iter().enumerate() {
+            assert_eq!(best.map(|(rwy, _)| rwy), (i % 2 == 0).then_some(1));
+        }
+    }
+
+    #[test]
+    fn finds_alternates() {
+        let nd = fixtures::nd();
+        let mut route = Route::new();
+        route
+            .decode("13509KT N0107 A025 EDDH RWY33 DHN2 DHN1 EDHF RWY20", &nd)
+            .expect("route should decode");
+
+        let perf = fixtures::performance();
+        let mb = fixtures::mass_and_balance();
+
+        // the destination EDHF is no alternate but EDDH is
+        let short = fixtures::landing_performance(1000.0);
+        let alternates = AlternateFinder::new(&perf, &short, &mb).find(&nd, &route);
+        let idents: Vec<String> = alternates.iter().map(|a| a.airport().ident()).collect();
+        assert_eq!(idents, vec!["EDDH"]);
+        assert_eq!(alternates[0].rwy().designator, "33");
+        assert!(alternates[0].fuel().is_some());
+        assert!(alternates[0].analysis().margin().to_si() > 0.0);
+
+        // EDDH is too far
+        let alternates = AlternateFinder::new(&perf, &short, &mb)
+            .radius(Length::nm(10.0))
+            .find(&nd, &route);
+        assert!(alternates.is_empty());
+
+        // the runway is too short
+        let long = fixtures::landing_performance(20000.0);
+        assert!(AlternateFinder::new(&perf, &long, &mb)
+            .find(&nd, &route)
+            .is_empty());
+    }
+}
@@ -0,0 +1,306 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use time::OffsetDateTime;
+
+use super::{FuelPlanning, Performance};
+use crate::measurements::Mass;
+use crate::route::{Route, Tracker};
+use crate::{Fuel, FuelType};
+
+/// The planned fuel burned in kg and time in seconds from the start of the
+/// route to a point of it.
+#[derive(Copy, Clone, PartialEq, Debug, Default)]
+struct Planned {
+    fuel: f32,
+    time: f32,
+}
+
+/// A fuel reading and the planned progress at the time of the reading.
+#[derive(Copy, Clone, PartialEq, Debug)]
+struct Reading {
+    fuel: f32,
+    time: OffsetDateTime,
+    planned: Planned,
+}
+
+/// Status of the projected landing fuel.
+#[repr(C)]
+#[derive(Copy, Clone, Eq, PartialEq, Debug)]
+pub enum FuelStatus {
+    /// The landing fuel covers the alternate and final reserve fuel.
+    Sufficient,
+    /// The landing fuel covers the final reserve but not the alternate fuel.
+    BelowAlternate,
+    /// The landing fuel is below the final reserve fuel.
+    BelowReserve,
+}
+
+/// The fuel projected from the latest reading.
+#[derive(Copy, Clone, PartialEq, Debug)]
+pub struct FuelProjection {
+    on_board: Fuel,
+    landing: Fuel,
+    status: FuelStatus,
+}
+
+/// In-flight monitor of the fuel.
+///
+/// The monitor takes the planned fuel and ETE of the legs from
+/// [`Route::accumulate_legs`] as cumulative sums, thus the planned fuel up to
+/// any point of the route is known without iterating the legs. The progress
+/// along the route is updated from the [`Tracker`], and fuel readings entered
+/// in flight. From the readings the monitor derives the actual fuel flow and
+/// from the elapsed time the pace compared with the plan. Both are applied to
+/// the remaining part of the route to project the landing fuel. Each update
+/// and projection takes constant time.
+///
+/// # Examples
+///
+/// ```
+/// # use efb::fp::{FuelMonitor, FuelStatus, FuelPlanning, Performance};
+/// # use efb::route::{Route, Tracker};
+/// # use efb::Fuel;
+/// # use time::OffsetDateTime;
+/// # fn monitor(route: &Route, perf: &Performance, planning: &FuelPlanning, tracker: &Tracker, fob: Fuel) {
+/// let mut monitor = FuelMonitor::new(route, perf, planning).expect("route should have fuel");
+///
+/// // on each position
+/// monitor.progress(tracker, OffsetDateTime::now_utc());
+///
+/// // on each reading
+/// monitor.reading(fob, OffsetDateTime::now_utc());
+///
+/// if let Some(projection) = monitor.projection() {
+///     if projection.status() != FuelStatus::Sufficient {
+///         println!("landing with {}", projection.landing());
+///     }
+/// }
+/// # }
+/// ```
+#[derive(Clone, PartialEq, Debug)]
+pub struct FuelMonitor {
+    fuel_type: FuelType,
+    /// The planned totals up to the end of each leg led by the start.
+    totals: Vec<Planned>,
+    /// The distance of each leg in NM.
+    dists: Vec<f32>,
+    /// The final reserve fuel in kg.
+    reserve: f32,
+    /// The alternate fuel in kg.
+    alternate: f32,
+    progress: Planned,
+    now: Option<OffsetDateTime>,
+    first: Option<Reading>,
+    latest: Option<Reading>,
+}
+
+impl FuelMonitor {
+    /// Creates a monitor of the `route` flown with the `perf` and the reserve
+    /// and alternate fuel of the `planning`.
+    ///
+    /// Returns `None` if the fuel or ETE of any leg is unknown.
+    pub fn new(route: &Route, perf: &Performance, planning: &FuelPlanning) -> Option<Self> {
+        let mut totals = vec![Planned::default()];
+        for totals_to_leg in route.accumulate_legs(Some(perf)) {
+            totals.push(Planned {
+                fuel: totals_to_leg.fuel()?.mass.to_si(),
+                time: totals_to_leg.ete()?.to_si() as f32,
+            });
+        }
+
+        Some(Self {
+            fuel_type: planning.trip().fuel_type,
+            totals,
+            dists: route.legs().iter().map(|leg| *leg.dist().value()).collect(),
+            reserve: planning.reserve().mass.to_si(),
+            alternate: planning.alternate().map_or(0.0, |fuel| fuel.mass.to_si()),
+            progress: Planned::default(),
+            now: None,
+            first: None,
+            latest: None,
+        })
+    }
+
+    /// Updates the progress along the route from the `tracker` at the
+    /// `time`.
+    pub fn progress(&mut self, tracker: &Tracker, time: OffsetDateTime) {
+        self.now = Some(time);
+        self.progress = match tracker.active() {
+            Some(i) if i < self.dists.len() => {
+                let (start, end) = (self.totals[i], self.totals[i + 1]);
+                let f = if self.dists[i] > 0.0 {
+                    (1.0 - tracker.dtg().value() / self.dists[i]).clamp(0.0, 1.0)
+                } else {
+                    1.0
+                };
+
+                Planned {
+                    fuel: start.fuel + (end.fuel - start.fuel) * f,
+                    time: start.time + (end.time - start.time) * f,
+                }
+            }
+            _ if tracker.is_passed() => self.total(),
+            _ => self.progress,
+        };
+    }
+
+    /// Enters the fuel on board (FOB) read at the `time`.
+    pub fn reading(&mut self, fob: Fuel, time: OffsetDateTime) {
+        let reading = Reading {
+            fuel: fob.mass.to_si(),
+            time,
+            planned: self.progress,
+        };
+
+        self.first.get_or_insert(reading);
+        self.latest = Some(reading);
+        self.now = Some(self.now.map_or(time, |now| now.max(time)));
+    }
+
+    /// Returns the fuel projected from the latest reading or `None` if no
+    /// fuel was read yet.
+    pub fn projection(&self) -> Option<FuelProjection> {
+        let (first, latest) = (self.first?, self.latest?);
+        let now = self.now.unwrap_or(latest.time);
+        let total = self.total();
+        let remaining = Planned {
+            fuel: total.fuel - self.progress.fuel,
+            time: total.time - self.progress.time,
+        };
+
+        // the actual fuel flow between the readings or the planned if both
+        // readings are too close
+        let read = (latest.time - first.time).as_seconds_f32();
+        let ff = if read > 0.0 && first.fuel > latest.fuel {
+            (first.fuel - latest.fuel) / read
+        } else if remaining.time > 0.0 {
+            remaining.fuel / remaining.time
+        } else {
+            0.0
+        };
+
+        // the actual time compared with the planned time since the first
+        // reading, e.g. more than one if slower than planned or in a hold
+        let elapsed = (now - first.time).as_seconds_f32();
+        let planned = self.progress.time - first.planned.time;
+        let pace = if elapsed > 0.0 && planned > 0.0 {
+            elapsed / planned
+        } else {
+            1.0
+        };
+
+        let on_board = latest.fuel - ff * (now - latest.time).as_seconds_f32().max(0.0);
+        let landing = on_board - ff * remaining.time * pace;
+
+        let status = if landing >= self.reserve + self.alternate {
+            FuelStatus::Sufficient
+        } else if landing >= self.reserve {
+            FuelStatus::BelowAlternate
+        } else {
+            FuelStatus::BelowReserve
+        };
+
+        Some(FuelProjection {
+            on_board: self.fuel(on_board),
+            landing: self.fuel(landing),
+            status,
+        })
+    }
+
+    fn total(&self) -> Planned {
+        self.totals.last().copied().unwrap_or_default()
+    }
+
+    fn fuel(&self, kg: f32) -> Fuel {
+        Fuel::new(Mass::kg(kg), self.fuel_type)
+    }
+}
+
+impl FuelProjection {
+    /// The fuel on board at the latest progress.
+    pub fn on_board(&self) -> &Fuel {
+        &self.on_board
+    }
+
+    /// The fuel on board after landing at the destination.
+    pub fn landing(&self) -> &Fuel {
+        &self.landing
+    }
+
+    /// The status of the landing fuel compared with the alternate and final
+    /// reserve fuel.
+    pub fn status(&self) -> FuelStatus {
+        self.status
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::aircraft::Aircraft;
+    use crate::fixtures;
+    use crate::fp::{FuelPolicy, Reserve};
+    use crate::measurements::{Duration, Length, Speed, Volume};
+    use crate::nd::Fix;
+
+    #[test]
+    fn projects_landing_fuel() {
+        let route = fixtures::route("13509KT N0107 A025 EDDH ABBEN UL126 DELTA EDHF");
+        let perf = fixtures::performance();
+        let aircraft = Aircraft::builder()
+            .registration(String::from("N12345"))
+            .empty_mass(Mass::kg(800.0))
+            .empty_balance(Length::m(1.0))
+            .fuel_type(FuelType::Diesel)
+            .build()
+            .expect("aircraft should build");
+        let planning = FuelPlanning::new(
+            &aircraft,
+            &FuelPolicy::ManualFuel(diesel!(Volume::l(80.0))),
+            diesel!(Volume::l(2.0)),
+            &route,
+            &Reserve::Manual(Duration::s(1800)),
+            &perf,
+        )
+        .expect("fuel should be planned");
+
+        let trip = planning.trip().mass.to_si();
+        let fob = diesel!(Volume::l(78.0));
+        let mut tracker = Tracker::new(&route);
+        let mut monitor =
+            FuelMonitor::new(&route, &perf, &planning).expect("route should have fuel");
+
+        // takeoff as planned
+        let t0 = OffsetDateTime::UNIX_EPOCH;
+        tracker.update(&route.legs()[0].from().coordinate(), Speed::kt(107.0), t0);
+        monitor.progress(&tracker, t0);
+        monitor.reading(fob, t0);
+
+        let projection = monitor.projection().expect("fuel should be read");
+        assert!((projection.landing().mass.to_si() - (fob.mass.to_si() - trip)).abs() < 0.1);
+        assert_eq!(projection.status(), FuelStatus::Sufficient);
+
+        // the first leg took twice as long and fuel as planned
+        let leg = &route.legs()[0];
+        let t1 = t0 + time::Duration::seconds(2 * leg.ete().unwrap().to_si() as i64);
+        tracker.update(&leg.to().coordinate(), Speed::kt(53.0), t1);
+        monitor.progress(&tracker, t1);
+        monitor.reading(fob - leg.fuel(&perf).unwrap() * 2.0, t1);
+
+        let projection = monitor.projection().expect("fuel should be read");
+        assert!((projection.landing().mass.to_si() - (fob.mass.to_si() - 2.0 * trip)).abs() < 0.1);
+    }
+}
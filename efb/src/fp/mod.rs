@@ -20,22 +20,29 @@
 //!
 //! - [`FuelPlanning`] to estimate the fuel required for the trip including any
 //!   safety reserves
+//! - [`FuelMonitor`] to project the landing fuel in flight from fuel readings
 //! - [`MassAndBalance`] to check if the mass and CG are within the aircraft's
 //!   bounds
+//! - [`AlternateFinder`] to rank the airports near the destination as
+//!   alternates
 //! - [`RunwayAnalysis`] to estimate the ground roll and distance to clear a
 //!   50ft obstacle on takeoff or landing
 
 #[cfg(feature = "serde")]
 use serde::{Deserialize, Serialize};
 
+mod alternate;
 mod builder;
+mod fuel_monitor;
 mod fuel_planning;
 mod mb;
 mod perf;
 mod runway_analysis;
 mod takeoff_landing_performance;
 
+pub use alternate::{Alternate, AlternateFinder};
 pub use builder::*;
+pub use fuel_monitor::{FuelMonitor, FuelProjection, FuelStatus};
 pub use fuel_planning::*;
 pub use mb::MassAndBalance;
 pub use perf::{Performance, PerformanceTable, PerformanceTableRow};
@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::io::{self, Write};
+
+use crate::geom::{BBox, Coordinate};
+use crate::nd::{Airport, Airspace, Fix, NavigationData, Waypoint};
+
+/// The record separator that starts each text in a GeoJSON text sequence.
+const RS: u8 = 0x1e;
+
+/// Writes navigation data as [GeoJSON text sequence] to an [`io::Write`].
+///
+/// Each airspace, airport or waypoint is written as a single feature when it's
+/// passed to the writer, so arbitrary large navigation data can be exported
+/// without building the document in memory. Every feature carries its
+/// bounding box, which lets a reader skip features outside an area without
+/// parsing their geometry.
+///
+/// [GeoJSON text sequence]: https://www.rfc-editor.org/rfc/rfc8142
+pub struct FeatureWriter<W: Write> {
+    writer: W,
+}
+
+impl<W: Write> FeatureWriter<W> {
+    pub fn new(writer: W) -> Self {
+        Self { writer }
+    }
+
+    /// Writes the airspace as feature with a polygon geometry.
+    pub fn write_airspace(&mut self, airspace: &Airspace) -> io::Result<()> {
+        let w = &mut self.writer;
+
+        w.write_all(&[RS])?;
+        w.write_all(br#"{"type":"Feature","#)?;
+        if let Some(bbox) = airspace.polygon.bbox() {
+            write_bbox(w, &bbox)?;
+            w.write_all(b",")?;
+        }
+
+        w.write_all(br#""geometry":{"type":"Polygon","coordinates":[["#)?;
+        let mut coords = airspace.polygon.iter();
+        if let Some(first) = coords.next() {
+            write_position(w, first)?;
+            let mut last = first;
+            for coord in coords {
+                w.write_all(b",")?;
+                write_position(w, coord)?;
+                last = coord;
+            }
+            // a linear ring must end at its first position
+            if last != first {
+                w.write_all(b",")?;
+                write_position(w, first)?;
+            }
+        }
+        w.write_all(b"]]},")?;
+
+        w.write_all(br#""properties":{"kind":"airspace","name":"#)?;
+        write_str(w, &airspace.name)?;
+        w.write_all(br#","class":"#)?;
+        write_str(w, &airspace.class.to_string())?;
+        w.write_all(br#","floor":"#)?;
+        write_str(w, &airspace.floor.to_string())?;
+        w.write_all(br#","ceiling":"#)?;
+        write_str(w, &airspace.ceiling.to_string())?;
+        w.write_all(b"}}\n")
+    }
+
+    /// Writes the airport as feature with a point geometry.
+    pub fn write_airport(&mut self, airport: &Airport) -> io::Result<()> {
+        self.write_point(airport, |w| {
+            w.write_all(br#""kind":"airport","ident":"#)?;
+            write_str(w, &airport.icao_ident)?;
+            w.write_all(br#","iata":"#)?;
+            write_str(w, &airport.iata_designator)?;
+            w.write_all(br#","name":"#)?;
+            write_str(w, &airport.name)?;
+            w.write_all(br#","elevation":"#)?;
+            write_str(w, &airport.elevation.to_string())
+        })
+    }
+
+    /// Writes the waypoint as feature with a point geometry.
+    pub fn write_waypoint(&mut self, waypoint: &Waypoint) -> io::Result<()> {
+        self.write_point(waypoint, |w| {
+            w.write_all(br#""kind":"waypoint","ident":"#)?;
+            write_str(w, &waypoint.ident())?;
+            w.write_all(br#","desc":"#)?;
+            write_str(w, &waypoint.desc)
+        })
+    }
+
+    /// Flushes and returns the underlying writer.
+    pub fn into_inner(mut self) -> io::Result<W> {
+        self.writer.flush()?;
+        Ok(self.writer)
+    }
+
+    fn write_point(
+        &mut self,
+        fix: &impl Fix,
+        properties: impl FnOnce(&mut W) -> io::Result<()>,
+    ) -> io::Result<()> {
+        let w = &mut self.writer;
+        let coord = fix.coordinate();
+
+        w.write_all(&[RS])?;
+        w.write_all(br#"{"type":"Feature","#)?;
+        if let Some(bbox) = BBox::new(&[coord]) {
+            write_bbox(w, &bbox)?;
+            w.write_all(b",")?;
+        }
+        w.write_all(br#""geometry":{"type":"Point","coordinates":"#)?;
+        write_position(w, &coord)?;
+        w.write_all(br#"},"properties":{"#)?;
+        properties(w)?;
+        w.write_all(b"}}\n")
+    }
+}
+
+impl NavigationData {
+    /// Writes all airspaces, airports and waypoints as [GeoJSON text
+    /// sequence] to the `writer`.
+    ///
+    /// The features are written one after another as they are iterated, thus
+    /// a buffered `writer` should be used for files or sockets.
+    ///
+    /// [GeoJSON text sequence]: https://www.rfc-editor.org/rfc/rfc8142
+    #[cfg_attr(docsrs, doc(cfg(feature = "geojson")))]
+    pub fn write_geojson_seq<W: Write>(&self, writer: W) -> io::Result<()> {
+        let mut features = FeatureWriter::new(writer);
+
+        for airspace in self.airspaces() {
+            features.write_airspace(airspace)?;
+        }
+
+        for airport in self.airports() {
+            features.write_airport(airport)?;
+        }
+
+        for waypoint in self.waypoints() {
+            features.write_waypoint(waypoint)?;
+        }
+
+        features.into_inner().map(|_| ())
+    }
+}
+
+fn write_position<W: Write>(w: &mut W, coord: &Coordinate) -> io::Result<()> {
+    write!(w, "[{},{}]", coord.longitude, coord.latitude)
+}
+
+fn write_bbox<W: Write>(w: &mut W, bbox: &BBox) -> io::Result<()> {
+    write!(
+        w,
+        r#""bbox":[{},{},{},{}]"#,
+        bbox.sw().longitude,
+        bbox.sw().latitude,
+        bbox.ne().longitude,
+        bbox.ne().latitude
+    )
+}
+
+fn write_str<W: Write>(w: &mut W, s: &str) -> io::Result<()> {
+    w.write_all(b"\"")?;
+    for c in s.chars() {
+        match c {
+            '"' => w.write_all(b"\\\"")?,
+            '\\' => w.write_all(b"\\\\")?,
+            c if c.is_control() => write!(w, "\\u{:04x}", c as u32)?,
+            c => write!(w, "{c}")?,
+        }
+    }
+    w.write_all(b"\"")
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn writes_feature_sequence() {
+        let nd = NavigationData::try_from_openair(
+            r#"AC D
+AN TMA "BREMEN" A
+AH FL 65
+AL 1500msl
+DP 53:06:04 N 8:58:30 E
+DP 53:06:10 N 9:04:45 E
+DP 52:58:13 N 9:05:04 E
+DP 52:58:08 N 8:58:56 E
+"#,
+        )
+        .expect("airspace should be valid");
+
+        let mut buffer = Vec::new();
+        nd.write_geojson_seq(&mut buffer)
+            .expect("writing to a vector should not fail");
+        let text = String::from_utf8(buffer).expect("GeoJSON should be UTF-8");
+
+        assert!(text.starts_with("\u{1e}{\"type\":\"Feature\",\"bbox\":["));
+        assert!(text.ends_with("}}\n"));
+        assert_eq!(text.matches('\u{1e}').count(), 1);
+        assert!(text.contains(r#""name":"TMA \"BREMEN\" A","class":"Class D""#));
+
+        // the ring is closed with its first position
+        let ring = text
+            .split(r#""coordinates":[["#)
+            .nth(1)
+            .and_then(|s| s.split("]]").next())
+            .expect("polygon should have a ring");
+        let positions: Vec<&str> = ring.split("],[").collect();
+        assert_eq!(positions.len(), 5);
+        assert_eq!(
+            positions[0].trim_start_matches('['),
+            positions[4].trim_end_matches(']')
+        );
+    }
+}
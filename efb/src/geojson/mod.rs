@@ -13,5 +13,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+mod export;
 mod geom;
 mod route;
+
+pub use export::FeatureWriter;
@@ -58,6 +58,20 @@ impl BBox {
     pub fn ne(&self) -> &Coordinate {
         &self.ne
     }
+
+    /// Returns `true` if the point is within the box or on its bounds.
+    pub fn contains(&self, point: &Coordinate) -> bool {
+        (self.sw.latitude..=self.ne.latitude).contains(&point.latitude)
+            && (self.sw.longitude..=self.ne.longitude).contains(&point.longitude)
+    }
+
+    /// Returns `true` if both boxes overlap.
+    pub fn intersects(&self, other: &BBox) -> bool {
+        self.sw.latitude <= other.ne.latitude
+            && other.sw.latitude <= self.ne.latitude
+            && self.sw.longitude <= other.ne.longitude
+            && other.sw.longitude <= self.ne.longitude
+    }
 }
 
 #[cfg(test)]
@@ -90,4 +104,18 @@ mod tests {
         assert_eq!(bbox.sw(), &sw);
         assert_eq!(bbox.ne(), &ne);
     }
+
+    #[test]
+    fn bbox_contains_and_intersects() {
+        let bbox = BBox::new(&[coord!(0.0, 0.0), coord!(10.0, 10.0)]).expect("bbox should be some");
+        let overlapping =
+            BBox::new(&[coord!(5.0, 5.0), coord!(15.0, 15.0)]).expect("bbox should be some");
+        let disjoint =
+            BBox::new(&[coord!(11.0, 0.0), coord!(20.0, 10.0)]).expect("bbox should be some");
+
+        assert!(bbox.contains(&coord!(5.0, 10.0)));
+        assert!(!bbox.contains(&coord!(5.0, 10.1)));
+        assert!(bbox.intersects(&overlapping));
+        assert!(!bbox.intersects(&disjoint));
+    }
 }
@@ -0,0 +1,298 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#[cfg(feature = "serde")]
+use serde::{Deserialize, Serialize};
+
+use super::{BBox, Coordinate};
+
+/// A cell of a hierarchical grid over latitude and longitude.
+///
+/// The world is the single cell of level 0, which is split into four cells
+/// at each level down to the leaf cells of level 30 that are less than a
+/// centimeter wide. The ID of a cell is an integer with the position of the
+/// cell along a Z-order curve, followed by a single set bit that marks the
+/// level, similar to the cell IDs of the [S2] library:
+///
+/// ```text
+/// level 1:  pp10000...0
+/// level 2:  pppp100...0
+/// ```
+///
+/// Thus, the IDs of all cells within a cell are a continuous range, cells
+/// that are close to each other tend to have close IDs, and the ID of a
+/// coordinate at some level is found by cutting off bits. This makes the ID
+/// a key to sort, shard or cache by region.
+///
+/// [S2]: https://s2geometry.io/devguide/s2cell_hierarchy
+#[derive(Copy, Clone, Eq, PartialEq, Ord, PartialOrd, Hash, Debug)]
+#[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
+pub struct CellId(u64);
+
+impl CellId {
+    /// The level of the leaf cells.
+    pub const MAX_LEVEL: u8 = 30;
+
+    /// Returns the cell at the `level` that contains the coordinate.
+    ///
+    /// Levels above [`MAX_LEVEL`] are clamped.
+    ///
+    /// [`MAX_LEVEL`]: CellId::MAX_LEVEL
+    pub fn new(coord: &Coordinate, level: u8) -> Self {
+        let scale = (1u64 << Self::MAX_LEVEL) as f64;
+        let max = (1u32 << Self::MAX_LEVEL) - 1;
+        let i = ((coord.longitude as f64 + 180.0) / 360.0 * scale).clamp(0.0, max as f64) as u32;
+        let j = ((coord.latitude as f64 + 90.0) / 180.0 * scale).clamp(0.0, max as f64) as u32;
+
+        Self::from_leaf(i, j).parent(level.min(Self::MAX_LEVEL))
+    }
+
+    /// Returns the cell with the `id` or `None` if it's no valid cell ID.
+    pub fn from_id(id: u64) -> Option<Self> {
+        let lsb = id.trailing_zeros();
+        (id != 0 && lsb % 2 == 0 && lsb <= 2 * Self::MAX_LEVEL as u32 && id >> 61 == 0)
+            .then_some(Self(id))
+    }
+
+    /// Returns the cell at the `level` with the column `i` counted from 180°
+    /// west and the row `j` counted from 90° south.
+    fn from_ij(i: u32, j: u32, level: u8) -> Self {
+        let shift = Self::MAX_LEVEL - level;
+        Self::from_leaf(i << shift, j << shift).parent(level)
+    }
+
+    fn from_leaf(i: u32, j: u32) -> Self {
+        Self((interleave(i, j) << 1) | 1)
+    }
+
+    /// Returns the integer ID.
+    pub fn id(&self) -> u64 {
+        self.0
+    }
+
+    pub fn level(&self) -> u8 {
+        Self::MAX_LEVEL - (self.0.trailing_zeros() / 2) as u8
+    }
+
+    /// Returns the cell at the `level` that contains this cell, or the cell
+    /// itself if the `level` isn't above the cell's level.
+    pub fn parent(&self, level: u8) -> Self {
+        if level >= self.level() {
+            return *self;
+        }
+
+        let lsb = lsb(level);
+        Self((self.0 & !((lsb << 1) - 1)) | lsb)
+    }
+
+    /// Returns the four cells of the next level within this cell, or `None`
+    /// if this is a leaf cell.
+    pub fn children(&self) -> Option<[Self; 4]> {
+        let lsb = self.lsb();
+        if lsb == 1 {
+            return None;
+        }
+
+        let first = self.0 - lsb + (lsb >> 2);
+        let step = lsb >> 1;
+        Some([0, 1, 2, 3].map(|k| Self(first + k * step)))
+    }
+
+    /// Returns `true` if the `other` cell is this cell or within it.
+    pub fn contains(&self, other: &CellId) -> bool {
+        let lsb = self.lsb();
+        (self.0 - (lsb - 1)..=self.0 + (lsb - 1)).contains(&other.0)
+    }
+
+    /// Returns the up to eight cells of the same level around this cell.
+    ///
+    /// The cells wrap around at the antimeridian but not at the poles.
+    pub fn neighbors(&self) -> impl Iterator<Item = Self> {
+        let level = self.level();
+        let (i, j) = self.ij();
+        let n = 1i64 << level;
+        let this = *self;
+
+        let mut cells: Vec<Self> = (-1..=1)
+            .flat_map(|dj| (-1..=1).map(move |di| (di, dj)))
+            .filter(|&(di, dj)| (di, dj) != (0, 0))
+            .filter_map(|(di, dj)| {
+                let j = j as i64 + dj;
+                let i = (i as i64 + di).rem_euclid(n);
+                (0..n)
+                    .contains(&j)
+                    .then(|| Self::from_ij(i as u32, j as u32, level))
+            })
+            .filter(|cell| *cell != this)
+            .collect();
+
+        // a level with less than three columns wraps to the same cells
+        cells.sort_unstable();
+        cells.dedup();
+        cells.into_iter()
+    }
+
+    /// Returns the cells at the `level` that cover the `bbox`.
+    pub fn covering(bbox: &BBox, level: u8) -> impl Iterator<Item = Self> {
+        let level = level.min(Self::MAX_LEVEL);
+        let (sw, ne) = (Self::new(bbox.sw(), level), Self::new(bbox.ne(), level));
+        let ((west, south), (east, north)) = (sw.ij(), ne.ij());
+
+        (south..=north).flat_map(move |j| (west..=east).map(move |i| Self::from_ij(i, j, level)))
+    }
+
+    /// Returns the bounds of the cell.
+    pub fn bbox(&self) -> BBox {
+        let (west, south, east, north) = self.bounds();
+        BBox::new(&[Coordinate::new(south, west), Coordinate::new(north, east)])
+            .expect("cell should have bounds")
+    }
+
+    /// Returns the center of the cell.
+    pub fn center(&self) -> Coordinate {
+        let (west, south, east, north) = self.bounds();
+        Coordinate::new((south + north) / 2.0, (west + east) / 2.0)
+    }
+
+    fn lsb(&self) -> u64 {
+        self.0 & self.0.wrapping_neg()
+    }
+
+    /// Returns the column and row of the cell within its level.
+    fn ij(&self) -> (u32, u32) {
+        let (i, j) = deinterleave(self.0 >> 1);
+        let shift = Self::MAX_LEVEL - self.level();
+        (i >> shift, j >> shift)
+    }
+
+    fn bounds(&self) -> (f32, f32, f32, f32) {
+        let (i, j) = self.ij();
+        let n = (1u64 << self.level()) as f64;
+        let lon = |i: u32| (i as f64 / n * 360.0 - 180.0) as f32;
+        let lat = |j: u32| (j as f64 / n * 180.0 - 90.0) as f32;
+        (lon(i), lat(j), lon(i + 1), lat(j + 1))
+    }
+}
+
+fn lsb(level: u8) -> u64 {
+    1 << (2 * (CellId::MAX_LEVEL - level))
+}
+
+/// Returns the bits of `i` and `j` interleaved with `i` at the odd bits.
+fn interleave(i: u32, j: u32) -> u64 {
+    (spread(i) << 1) | spread(j)
+}
+
+fn deinterleave(z: u64) -> (u32, u32) {
+    (compact(z >> 1), compact(z))
+}
+
+/// Spreads the bits of `x` to the even bits.
+fn spread(x: u32) -> u64 {
+    let mut x = x as u64;
+    x = (x | (x << 16)) & 0x0000_ffff_0000_ffff;
+    x = (x | (x << 8)) & 0x00ff_00ff_00ff_00ff;
+    x = (x | (x << 4)) & 0x0f0f_0f0f_0f0f_0f0f;
+    x = (x | (x << 2)) & 0x3333_3333_3333_3333;
+    (x | (x << 1)) & 0x5555_5555_5555_5555
+}
+
+/// Compacts the even bits of `x`, the inverse of [`spread`].
+fn compact(x: u64) -> u32 {
+    let mut x = x & 0x5555_5555_5555_5555;
+    x = (x | (x >> 1)) & 0x3333_3333_3333_3333;
+    x = (x | (x >> 2)) & 0x0f0f_0f0f_0f0f_0f0f;
+    x = (x | (x >> 4)) & 0x00ff_00ff_00ff_00ff;
+    x = (x | (x >> 8)) & 0x0000_ffff_0000_ffff;
+    ((x | (x >> 16)) & 0x0000_0000_ffff_ffff) as u32
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const EDDH: Coordinate = coord!(53.63, 9.99);
+
+    #[test]
+    fn encodes_level() {
+        assert_eq!(CellId::new(&EDDH, 0).id(), 1 << 60);
+        for level in [0, 1, 12, CellId::MAX_LEVEL] {
+            assert_eq!(CellId::new(&EDDH, level).level(), level);
+        }
+        assert_eq!(CellId::new(&EDDH, 42).level(), CellId::MAX_LEVEL);
+    }
+
+    #[test]
+    fn cells_contain_coordinate() {
+        for level in [1, 8, 16, 24] {
+            let cell = CellId::new(&EDDH, level);
+            assert!(cell.bbox().contains(&EDDH));
+            assert_eq!(CellId::new(&cell.center(), level), cell);
+            assert_eq!(CellId::from_id(cell.id()), Some(cell));
+        }
+        assert_eq!(CellId::from_id(0), None);
+        assert_eq!(CellId::from_id(2), None);
+    }
+
+    #[test]
+    fn hierarchy() {
+        let leaf = CellId::new(&EDDH, CellId::MAX_LEVEL);
+        let cell = leaf.parent(10);
+
+        assert!(cell.contains(&leaf));
+        assert!(cell.parent(4).contains(&cell));
+        assert!(!cell.contains(&cell.parent(4)));
+        assert_eq!(leaf.children(), None);
+
+        let children = cell.children().expect("cell should have children");
+        assert!(children.iter().all(|child| child.parent(10) == cell));
+        assert_eq!(
+            children
+                .iter()
+                .filter(|child| child.contains(&leaf))
+                .count(),
+            1
+        );
+    }
+
+    #[test]
+    fn neighbors_wrap_at_antimeridian() {
+        let cell = CellId::new(&coord!(53.63, 9.99), 8);
+        assert_eq!(cell.neighbors().count(), 8);
+        assert!(cell
+            .neighbors()
+            .all(|n| n.level() == 8 && n.bbox().intersects(&cell.bbox())));
+
+        let east = CellId::new(&coord!(0.0, 179.9), 4);
+        assert!(east
+            .neighbors()
+            .any(|n| n.bbox().contains(&coord!(0.0, -179.9))));
+
+        let pole = CellId::new(&coord!(89.9, 0.0), 4);
+        assert_eq!(pole.neighbors().count(), 5);
+        assert_eq!(CellId::new(&EDDH, 0).neighbors().count(), 0);
+    }
+
+    #[test]
+    fn covers_bbox() {
+        let bbox = BBox::new(&[coord!(53.0, 9.0), coord!(54.0, 10.0)]).expect("bbox");
+        let cells: Vec<CellId> = CellId::covering(&bbox, 6).collect();
+
+        assert!(cells.iter().all(|cell| cell.bbox().intersects(&bbox)));
+        assert!(cells
+            .iter()
+            .any(|cell| cell.contains(&CellId::new(&EDDH, 20))));
+    }
+}
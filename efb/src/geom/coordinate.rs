@@ -21,7 +21,8 @@ use serde::{Deserialize, Serialize};
 use crate::fc;
 use crate::measurements::{Angle, Length};
 
-mod constants {
+pub(crate) mod constants {
+    /// The mean radius of the earth in kilometers.
     pub const EARTH_MEAN_RADIUS: f32 = 6371.0072;
 }
 
@@ -77,6 +78,23 @@ impl Coordinate {
         Length::m(x * constants::EARTH_MEAN_RADIUS * 1000.0)
     }
 
+    /// Returns the point at the `dist` from this point when going along the
+    /// great circle with the initial `bearing`.
+    pub fn destination(&self, bearing: Angle, dist: Length) -> Coordinate {
+        let delta = dist.to_si() / (constants::EARTH_MEAN_RADIUS * 1000.0);
+        let theta = bearing.to_si();
+        let lat_a = self.latitude.to_radians();
+
+        let lat_b = (lat_a.sin() * delta.cos() + lat_a.cos() * delta.sin() * theta.cos()).asin();
+        let delta_long = (theta.sin() * delta.sin() * lat_a.cos())
+            .atan2(delta.cos() - lat_a.sin() * lat_b.sin());
+
+        Self {
+            latitude: lat_b.to_degrees(),
+            longitude: self.longitude + delta_long.to_degrees(),
+        }
+    }
+
     pub fn from_dms(latitude: (i8, u8, u8), longitude: (i16, u8, u8)) -> Self {
         Self {
             latitude: latitude.0.signum() as f32
@@ -127,4 +145,11 @@ mod tests {
             60.0
         );
     }
+
+    #[test]
+    fn destination() {
+        let dest = DHE.destination(DHE.bearing(&EDHF), DHE.dist(&EDHF));
+        assert!((dest.latitude - EDHF.latitude).abs() < 1e-3);
+        assert!((dest.longitude - EDHF.longitude).abs() < 1e-3);
+    }
 }
@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use crate::algorithm::{self, Point};
+use crate::geom::{BBox, Coordinate};
+use crate::measurements::{Length, LengthUnit};
+
+/// The longest part of a line that is treated as straight.
+const MAX_PART_NM: f32 = 60.0;
+
+const NM_PER_DEGREE: f32 = 60.0;
+
+/// A corridor to either side of a straight line.
+///
+/// The line is projected into a plane of nautical miles that is tangent to
+/// the earth at the line's center, which is accurate for lines of some ten
+/// nautical miles. Longer lines are split into parts by [`Corridor::along`].
+pub(crate) struct Corridor {
+    // the start of the line in degrees and its end in the plane
+    origin: (f32, f32),
+    end: (f32, f32),
+    kx: f32,
+    len: f32,
+    /// The distance in nautical miles to either side of the line.
+    pub(crate) radius: f32,
+    pub(crate) south: f32,
+    pub(crate) west: f32,
+    pub(crate) north: f32,
+    pub(crate) east: f32,
+}
+
+impl Corridor {
+    pub(crate) fn new(from: &Coordinate, to: &Coordinate, radius: Length) -> Self {
+        let radius = *radius.convert_to(LengthUnit::NauticalMiles).value();
+        let kx = NM_PER_DEGREE * ((from.latitude + to.latitude) / 2.0).to_radians().cos();
+        let lat_margin = radius / NM_PER_DEGREE;
+        let lon_margin = radius / kx.max(f32::EPSILON);
+
+        let mut corridor = Self {
+            origin: (from.latitude, from.longitude),
+            end: (0.0, 0.0),
+            kx,
+            len: 0.0,
+            radius,
+            south: from.latitude.min(to.latitude) - lat_margin,
+            west: from.longitude.min(to.longitude) - lon_margin,
+            north: from.latitude.max(to.latitude) + lat_margin,
+            east: from.longitude.max(to.longitude) + lon_margin,
+        };
+        corridor.end = corridor.project(to.latitude - from.latitude, to.longitude - from.longitude);
+        corridor.len = corridor.end.0.hypot(corridor.end.1);
+        corridor
+    }
+
+    /// Returns the corridors along the great circle from `from` to `to`,
+    /// split into parts of up to 60 NM.
+    pub(crate) fn along(
+        from: &Coordinate,
+        to: &Coordinate,
+        radius: Length,
+    ) -> impl Iterator<Item = Self> {
+        let (from, to) = (*from, *to);
+        let dist = from.dist(&to).convert_to(LengthUnit::NauticalMiles);
+        let bearing = from.bearing(&to);
+        let parts = (dist.value() / MAX_PART_NM).ceil().max(1.0) as usize;
+
+        let point = move |i: usize| {
+            if i == parts {
+                to
+            } else if i == 0 {
+                from
+            } else {
+                from.destination(bearing, dist * (i as f32 / parts as f32))
+            }
+        };
+
+        (1..=parts).map(move |i| Self::new(&point(i - 1), &point(i), radius))
+    }
+
+    /// Projects a difference in degrees into the plane.
+    pub(crate) fn project(&self, lat: f32, lon: f32) -> (f32, f32) {
+        (lon * self.kx, lat * NM_PER_DEGREE)
+    }
+
+    /// Returns the bounds of the corridor.
+    pub(crate) fn bbox(&self) -> BBox {
+        BBox::new(&[
+            Coordinate::new(self.south, self.west),
+            Coordinate::new(self.north, self.east),
+        ])
+        .expect("corridor should have bounds")
+    }
+
+    /// Returns the latitude and longitude of the line's start.
+    pub(crate) fn start(&self) -> (f32, f32) {
+        self.origin
+    }
+
+    /// Returns the length of the line in nautical miles.
+    pub(crate) fn len(&self) -> f32 {
+        self.len
+    }
+
+    /// Returns the distance in nautical miles of the point to the line.
+    pub(crate) fn dist(&self, lat: f32, lon: f32) -> f32 {
+        self.locate(lat, lon).1
+    }
+
+    /// Returns the along-track distance of the point's closest position on
+    /// the line and the point's distance to it, both in nautical miles.
+    pub(crate) fn locate(&self, lat: f32, lon: f32) -> (f32, f32) {
+        let p = self.project(lat - self.origin.0, lon - self.origin.1);
+        let b = self.end;
+        let t = if self.len > 0.0 {
+            ((p.0 * b.0 + p.1 * b.1) / (self.len * self.len)).clamp(0.0, 1.0)
+        } else {
+            0.0
+        };
+
+        (t * self.len, (p.0 - t * b.0).hypot(p.1 - t * b.1))
+    }
+
+    /// Returns the along-track distance at which the edge from `c` to `d`
+    /// comes closest to the line together with the distance between both,
+    /// which is zero if they cross. The points are latitude and longitude.
+    pub(crate) fn locate_edge(&self, c: (f32, f32), d: (f32, f32)) -> (f32, f32) {
+        let origin = Point { x: 0.0, y: 0.0 };
+        let end = Point {
+            x: self.end.0,
+            y: self.end.1,
+        };
+        let point = |(lat, lon): (f32, f32)| {
+            let (x, y) = self.project(lat - self.origin.0, lon - self.origin.1);
+            Point { x, y }
+        };
+        let (pc, pd) = (point(c), point(d));
+
+        if let Some(t) = algorithm::segment_intersection((origin, end), (pc, pd)) {
+            return (t * self.len, 0.0);
+        }
+
+        // otherwise an end point of one segment is closest to the other
+        let edge_dist = |p: Point| {
+            let (ex, ey) = (pd.x - pc.x, pd.y - pc.y);
+            let len = ex * ex + ey * ey;
+            let t = if len > 0.0 {
+                (((p.x - pc.x) * ex + (p.y - pc.y) * ey) / len).clamp(0.0, 1.0)
+            } else {
+                0.0
+            };
+            (p.x - pc.x - t * ex).hypot(p.y - pc.y - t * ey)
+        };
+
+        [
+            self.locate(c.0, c.1),
+            self.locate(d.0, d.1),
+            (0.0, edge_dist(origin)),
+            (self.len, edge_dist(end)),
+        ]
+        .into_iter()
+        .min_by(|a, b| a.1.total_cmp(&b.1).then(a.0.total_cmp(&b.0)))
+        .unwrap_or_default()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn dist_to_line() {
+        let corridor = Corridor::new(&coord!(53.0, 9.0), &coord!(53.0, 10.0), Length::nm(5.0));
+        assert_eq!(corridor.dist(53.1, 9.5).round(), 6.0);
+        // beyond the end of the line
+        assert_eq!(corridor.dist(53.0, 8.9).round(), 4.0);
+    }
+
+    #[test]
+    fn locates_edge() {
+        let corridor = Corridor::new(&coord!(53.0, 9.0), &coord!(53.0, 10.0), Length::nm(5.0));
+        let (along, dist) = corridor.locate_edge((52.9, 9.5), (53.1, 9.5));
+        assert_eq!((along.round(), dist), (18.0, 0.0));
+
+        // an edge north of the line's end
+        let (along, dist) = corridor.locate_edge((53.1, 10.0), (53.2, 10.5));
+        assert_eq!((along.round(), dist.round()), (36.0, 6.0));
+    }
+
+    #[test]
+    fn splits_long_lines() {
+        let (from, to) = (coord!(50.0, 8.0), coord!(54.0, 10.0));
+        assert_eq!(Corridor::along(&from, &to, Length::nm(5.0)).count(), 5);
+    }
+}
@@ -15,9 +15,14 @@
 
 //! Geometry.
 mod bbox;
+mod cell;
 mod coordinate;
+mod corridor;
 mod polygon;
 
-pub(crate) use bbox::*;
+pub use bbox::*;
+pub use cell::CellId;
+pub(crate) use coordinate::constants;
 pub use coordinate::*;
+pub(crate) use corridor::Corridor;
 pub use polygon::*;
@@ -18,7 +18,7 @@ use std::ops::Index;
 #[cfg(feature = "serde")]
 use serde::{Deserialize, Serialize};
 
-use super::Coordinate;
+use super::{BBox, Coordinate};
 use crate::algorithm;
 
 /// A polygon spawned by coordinates.
@@ -41,26 +41,59 @@ impl Polygon {
 
     /// Returns `true` if the given point is within the polygon's area.
     pub fn contains(&self, point: &Coordinate) -> bool {
-        algorithm::winding_number(
-            &algorithm::Point {
-                x: point.longitude,
-                y: point.latitude,
-            },
-            &self
-                .coords
-                .iter()
-                .map(|coord| algorithm::Point {
-                    x: coord.longitude,
-                    y: coord.latitude,
-                })
-                .collect::<Vec<algorithm::Point>>(),
-        ) != 0
+        !self.is_empty() && algorithm::winding_number(&self::point(point), &self.points()) != 0
+    }
+
+    /// Returns `true` if the polygon's area overlaps the `other` polygon's
+    /// area, i.e. their edges intersect or one polygon is within the other.
+    pub fn intersects(&self, other: &Polygon) -> bool {
+        let (a, b) = (self.points(), other.points());
+        if a.is_empty() || b.is_empty() {
+            return false;
+        }
+
+        a.windows(2).any(|e| {
+            b.windows(2)
+                .any(|f| algorithm::segments_intersect((e[0], e[1]), (f[0], f[1])))
+        }) || algorithm::winding_number(&a[0], &b) != 0
+            || algorithm::winding_number(&b[0], &a) != 0
+    }
+
+    /// Returns the bounding box around the polygon or [`None`] if the polygon
+    /// is empty.
+    pub fn bbox(&self) -> Option<BBox> {
+        BBox::new(&self.coords)
+    }
+
+    /// Returns the number of coordinates.
+    pub fn len(&self) -> usize {
+        self.coords.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.coords.is_empty()
+    }
+
+    /// Returns an iterator over the coordinates.
+    pub fn iter(&self) -> impl Iterator<Item = &Coordinate> {
+        self.coords.iter()
     }
 
     /// Consumes the Polygon, returning its inner vector of coordinates.
     pub fn into_inner(self) -> Vec<Coordinate> {
         self.coords
     }
+
+    fn points(&self) -> Vec<algorithm::Point> {
+        self.coords.iter().map(point).collect()
+    }
+}
+
+fn point(coord: &Coordinate) -> algorithm::Point {
+    algorithm::Point {
+        x: coord.longitude,
+        y: coord.latitude,
+    }
 }
 
 impl From<Vec<Coordinate>> for Polygon {
@@ -106,4 +139,24 @@ mod tests {
         ];
         assert!(!polygon.contains(&point));
     }
+
+    #[test]
+    fn polygons_intersect() {
+        let square = polygon![
+            (10.0, 10.0),
+            (20.0, 10.0),
+            (20.0, 20.0),
+            (10.0, 20.0),
+            (10.0, 10.0)
+        ];
+        let crossing = polygon![(15.0, 5.0), (15.0, 25.0), (16.0, 25.0), (15.0, 5.0)];
+        let within = polygon![(12.0, 12.0), (12.0, 13.0), (13.0, 13.0), (12.0, 12.0)];
+        let outside = polygon![(22.0, 12.0), (22.0, 13.0), (23.0, 13.0), (22.0, 12.0)];
+
+        assert!(square.intersects(&crossing));
+        assert!(square.intersects(&within));
+        assert!(within.intersects(&square));
+        assert!(!square.intersects(&outside));
+        assert!(!square.intersects(&Polygon::new()));
+    }
 }
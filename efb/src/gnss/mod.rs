@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Position input of a global navigation satellite system (GNSS).
+//!
+//! Positions are read from NMEA 0183 sentences by a [`NmeaReader`] that works
+//! on any byte stream, e.g. a serial port or a file. A recorded log file is
+//! played back in real or accelerated time by a [`Replay`] which stands in
+//! for a receiver e.g. on the ground. The positions are fed into the
+//! [`FMS`](crate::fms::FMS) to track the route in flight and into a
+//! [`TrackRecorder`] to compare the flown track with the route after
+//! landing.
+
+use time::OffsetDateTime;
+
+use crate::geom::Coordinate;
+use crate::measurements::{Angle, Length, Speed};
+
+mod nmea;
+mod replay;
+mod track;
+
+pub use nmea::NmeaReader;
+pub use replay::Replay;
+pub use track::{FlownLeg, TrackPoint, TrackRecorder};
+
+/// A position fix of a GNSS receiver.
+#[derive(Copy, Clone, PartialEq, Debug)]
+pub struct Position {
+    /// The position's coordinate.
+    pub coordinate: Coordinate,
+    /// The UTC time of the fix.
+    pub time: OffsetDateTime,
+    /// The ground speed.
+    pub gs: Speed,
+    /// The true track over ground if moving.
+    pub track: Option<Angle>,
+    /// The altitude above mean sea level if known.
+    pub altitude: Option<Length>,
+}
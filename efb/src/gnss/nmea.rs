@@ -0,0 +1,383 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::io::{self, Read};
+use std::str;
+
+use time::{Date, Month, PrimitiveDateTime, Time};
+
+use super::Position;
+use crate::geom::Coordinate;
+use crate::measurements::{Angle, Length, Speed};
+
+/// The size of the read buffer which holds several sentences of at most 82
+/// characters.
+const BUFFER_SIZE: usize = 1024;
+
+/// Reader of positions from NMEA 0183 sentences.
+///
+/// The reader yields a [`Position`] for each valid RMC sentence with the
+/// altitude of the GGA sentence of the same fix. Other sentences as well as
+/// sentences with an invalid checksum or without a fix are skipped. The bytes
+/// are read into a fixed buffer and parsed in place, thus no allocation is
+/// made per sentence.
+///
+/// Receivers send the GGA sentence of a fix before or after its RMC sentence.
+/// A position is yielded as soon as both are read. An RMC sentence without
+/// its GGA sentence is held back until the next fix starts or the stream
+/// ends.
+///
+/// # Examples
+///
+/// ```
+/// # use efb::gnss::NmeaReader;
+/// let log = b"$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n";
+/// let mut reader = NmeaReader::new(&log[..]);
+///
+/// let position = reader.next().unwrap().unwrap();
+/// assert_eq!(position.coordinate.latitude.round(), 48.0);
+/// ```
+pub struct NmeaReader<R> {
+    inner: R,
+    buf: [u8; BUFFER_SIZE],
+    start: usize,
+    end: usize,
+    eof: bool,
+    /// The time of day and altitude of the last GGA sentence.
+    gga: Option<(Time, Length)>,
+    /// The position of an RMC sentence that waits for its GGA sentence.
+    pending: Option<Position>,
+    skipped: usize,
+}
+
+impl<R: Read> NmeaReader<R> {
+    pub fn new(inner: R) -> Self {
+        Self {
+            inner,
+            buf: [0; BUFFER_SIZE],
+            start: 0,
+            end: 0,
+            eof: false,
+            gga: None,
+            pending: None,
+            skipped: 0,
+        }
+    }
+
+    /// Returns the number of sentences that were skipped since they were
+    /// malformed, e.g. the first partial sentence of a stream.
+    pub fn skipped(&self) -> usize {
+        self.skipped
+    }
+
+    /// Returns the next line without the line break.
+    fn line(&mut self) -> io::Result<Option<(usize, usize)>> {
+        loop {
+            if let Some(i) = self.buf[self.start..self.end]
+                .iter()
+                .position(|&b| b == b'\n')
+            {
+                let line = (self.start, self.start + i);
+                self.start += i + 1;
+                return Ok(Some(line));
+            }
+
+            if self.eof {
+                // the last line might not end with a line break
+                let line = (self.start, self.end);
+                self.start = self.end;
+                return Ok((line.0 < line.1).then_some(line));
+            }
+
+            if self.start > 0 {
+                self.buf.copy_within(self.start..self.end, 0);
+                self.end -= self.start;
+                self.start = 0;
+            } else if self.end == BUFFER_SIZE {
+                // no sentence is that long, thus the bytes are no NMEA
+                self.skipped += 1;
+                self.end = 0;
+            }
+
+            match self.inner.read(&mut self.buf[self.end..]) {
+                Ok(0) => self.eof = true,
+                Ok(n) => self.end += n,
+                Err(e) if e.kind() == io::ErrorKind::Interrupted => {}
+                Err(e) => return Err(e),
+            }
+        }
+    }
+}
+
+impl<R: Read> Iterator for NmeaReader<R> {
+    type Item = io::Result<Position>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        loop {
+            // the RMC sentence was preceded by its GGA sentence
+            if self.pending.as_ref().is_some_and(|p| p.altitude.is_some()) {
+                return self.pending.take().map(Ok);
+            }
+
+            let (start, end) = match self.line() {
+                Ok(Some(line)) => line,
+                Ok(None) => return self.pending.take().map(Ok),
+                Err(e) => return Some(Err(e)),
+            };
+
+            match Sentence::parse(self.buf[start..end].trim_ascii()) {
+                Some(Sentence::Rmc(rmc)) => {
+                    let altitude = self
+                        .gga
+                        .filter(|(time, _)| *time == rmc.time.time())
+                        .map(|(_, altitude)| altitude);
+
+                    // the GGA sentence of a pending position didn't follow
+                    if let Some(previous) = self.pending.replace(Position { altitude, ..rmc }) {
+                        return Some(Ok(previous));
+                    }
+                }
+                Some(Sentence::Gga(time, altitude)) => {
+                    self.gga = Some((time, altitude));
+                    if let Some(mut pending) = self.pending.take() {
+                        // a GGA sentence of another time starts the next fix
+                        if pending.time.time() == time {
+                            pending.altitude = Some(altitude);
+                        }
+                        return Some(Ok(pending));
+                    }
+                }
+                Some(Sentence::Other) => {}
+                None => self.skipped += 1,
+            }
+        }
+    }
+}
+
+enum Sentence {
+    Rmc(Position),
+    Gga(Time, Length),
+    Other,
+}
+
+impl Sentence {
+    /// Parses a sentence from a `line` without line break. Returns `None` if
+    /// the sentence is malformed.
+    fn parse(line: &[u8]) -> Option<Self> {
+        let body = checked(line)?;
+        let mut fields = body.split(|&b| b == b',');
+        let kind = fields.next()?;
+
+        // the sentence's kind follows a two letter talker ID e.g. GP or GN
+        match kind.get(2..)? {
+            b"RMC" => {
+                let time = time_of_day(fields.next()?)?;
+                if fields.next()? != b"A" {
+                    // the receiver has no valid fix
+                    return Some(Self::Other);
+                }
+
+                let coordinate = coordinate(&mut fields)?;
+                let gs = number(fields.next()?).unwrap_or_default();
+                let track = number(fields.next()?);
+                let date = date(fields.next()?)?;
+
+                Some(Self::Rmc(Position {
+                    coordinate,
+                    time: PrimitiveDateTime::new(date, time).assume_utc(),
+                    gs: Speed::kt(gs as f32),
+                    track: track.map(|t| Angle::t(t as f32)),
+                    altitude: None,
+                }))
+            }
+            b"GGA" => {
+                let time = time_of_day(fields.next()?)?;
+                // the quality follows the coordinate
+                let quality = fields.nth(4)?;
+                let altitude = fields.nth(2).and_then(number);
+
+                match altitude {
+                    Some(altitude) if quality != b"0" => {
+                        Some(Self::Gga(time, Length::m(altitude as f32)))
+                    }
+                    _ => Some(Self::Other),
+                }
+            }
+            _ => Some(Self::Other),
+        }
+    }
+}
+
+/// Returns the sentence's body between `$` and the checksum if the checksum
+/// matches.
+fn checked(line: &[u8]) -> Option<&[u8]> {
+    let line = line.strip_prefix(b"$")?;
+
+    match line.iter().position(|&b| b == b'*') {
+        Some(i) => {
+            let (body, checksum) = (&line[..i], &line[i + 1..]);
+            let expected = u8::from_str_radix(str::from_utf8(checksum).ok()?, 16).ok()?;
+            let actual = body.iter().fold(0, |sum, b| sum ^ b);
+            (expected == actual).then_some(body)
+        }
+        // the checksum is optional
+        None => Some(line),
+    }
+}
+
+fn number(field: &[u8]) -> Option<f64> {
+    str::from_utf8(field).ok()?.parse().ok()
+}
+
+fn digits(field: &[u8]) -> Option<u8> {
+    str::from_utf8(field).ok()?.parse().ok()
+}
+
+/// Parses the time of day `hhmmss.ss`.
+fn time_of_day(field: &[u8]) -> Option<Time> {
+    let (hhmmss, fraction) = field.split_at_checked(6)?;
+    let ms = match fraction {
+        [] => 0,
+        [b'.', ..] => (number(fraction)? * 1000.0).round() as u16,
+        _ => return None,
+    };
+
+    Time::from_hms_milli(
+        digits(&hhmmss[0..2])?,
+        digits(&hhmmss[2..4])?,
+        digits(&hhmmss[4..6])?,
+        ms.min(999),
+    )
+    .ok()
+}
+
+/// Parses the date `ddmmyy` which is in the years 2000 to 2099.
+fn date(field: &[u8]) -> Option<Date> {
+    if field.len() != 6 {
+        return None;
+    }
+
+    Date::from_calendar_date(
+        2000 + digits(&field[4..6])? as i32,
+        Month::try_from(digits(&field[2..4])?).ok()?,
+        digits(&field[0..2])?,
+    )
+    .ok()
+}
+
+/// Parses the next four fields `ddmm.mm,N,dddmm.mm,E` to a coordinate.
+fn coordinate<'a>(fields: &mut impl Iterator<Item = &'a [u8]>) -> Option<Coordinate> {
+    let mut angle = |positive: &[u8], negative: &[u8]| {
+        let value = number(fields.next()?)?;
+        let degrees = (value / 100.0).trunc();
+        let angle = degrees + (value - degrees * 100.0) / 60.0;
+
+        match fields.next()? {
+            hemisphere if hemisphere == positive => Some(angle as f32),
+            hemisphere if hemisphere == negative => Some(-angle as f32),
+            _ => None,
+        }
+    };
+
+    let latitude = angle(b"N", b"S")?;
+    let longitude = angle(b"E", b"W")?;
+    Some(Coordinate::new(latitude, longitude))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const LOG: &[u8] = b"1,A,5333.000,N,00958.000,E,100.0,045.0,181026,,*00\r
+$GPGGA,101500.00,5333.000,N,00958.000,E,1,08,0.9,15.0,M,40.0,M,,*5A\r
+$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r
+$GPRMC,101500.00,A,5333.000,N,00958.000,E,100.0,045.0,181026,,*38\r
+$GPRMC,101501.00,V,,,,,,,181026,,*17\r
+$GNRMC,101502.00,A,5333.000,S,00958.000,W,0.0,,181026,,,A*68
+";
+
+    #[test]
+    fn reads_positions() {
+        let mut reader = NmeaReader::new(LOG);
+
+        let position = reader.next().unwrap().unwrap();
+        assert_eq!(position.coordinate, Coordinate::new(53.55, 9.966666));
+        assert_eq!(position.gs, Speed::kt(100.0));
+        assert_eq!(position.track, Some(Angle::t(45.0)));
+        assert_eq!(position.altitude, Some(Length::m(15.0)));
+        assert_eq!(
+            position.time,
+            PrimitiveDateTime::new(
+                Date::from_calendar_date(2026, Month::October, 18).unwrap(),
+                Time::from_hms(10, 15, 0).unwrap()
+            )
+            .assume_utc()
+        );
+
+        let position = reader.next().unwrap().unwrap();
+        assert_eq!(position.coordinate, Coordinate::new(-53.55, -9.966666));
+        assert_eq!(position.track, None);
+        assert_eq!(position.altitude, None);
+
+        assert!(reader.next().is_none());
+        assert_eq!(reader.skipped(), 1);
+    }
+
+    #[test]
+    fn reads_from_small_chunks() {
+        struct Chunks<'a>(&'a [u8]);
+
+        impl Read for Chunks<'_> {
+            fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+                let n = self.0.len().min(buf.len()).min(7);
+                buf[..n].copy_from_slice(&self.0[..n]);
+                self.0 = &self.0[n..];
+                Ok(n)
+            }
+        }
+
+        assert_eq!(NmeaReader::new(Chunks(LOG)).count(), 2);
+    }
+
+    #[test]
+    fn pairs_sentences_in_either_order() {
+        let rmc = "$GPRMC,101500.00,A,5333.000,N,00958.000,E,100.0,045.0,181026,,*38\r\n";
+        let gga = "$GPGGA,101500.00,5333.000,N,00958.000,E,1,08,0.9,15.0,M,40.0,M,,*5A\r\n";
+        let next = "$GNRMC,101502.00,A,5333.000,S,00958.000,W,0.0,,181026,,,A*68\r\n";
+
+        for log in [
+            format!("{gga}{rmc}{next}"),
+            format!("{rmc}{gga}{next}"),
+            format!("{next}{gga}{rmc}"),
+        ] {
+            let altitudes: Vec<Option<Length>> = NmeaReader::new(log.as_bytes())
+                .map(|position| position.expect("position should be read").altitude)
+                .collect();
+            let expected = if log.starts_with(next) {
+                vec![None, Some(Length::m(15.0))]
+            } else {
+                vec![Some(Length::m(15.0)), None]
+            };
+            assert_eq!(altitudes, expected, "{log}");
+        }
+    }
+
+    #[test]
+    fn rejects_invalid_checksum() {
+        assert!(
+            Sentence::parse(b"$GPRMC,101500.00,A,5333.000,N,00958.000,E,1,2,181026,,*00").is_none()
+        );
+    }
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::io::{self, Read};
+use std::thread;
+use std::time::{Duration, Instant};
+
+use time::OffsetDateTime;
+
+use super::{NmeaReader, Position};
+
+/// Playback of a recorded NMEA log.
+///
+/// The replay yields the positions of the log at the pace at which they were
+/// recorded, accelerated by a factor. Thus, a replay of a log file stands in
+/// for a receiver. The pace is kept relative to the first position, which
+/// makes up for the time spent between two positions by the caller.
+///
+/// # Examples
+///
+/// ```no_run
+/// # use std::fs::File;
+/// # use efb::gnss::Replay;
+/// # use efb::prelude::FMS;
+/// # fn replay(fms: &mut FMS) -> std::io::Result<()> {
+/// // replay the flight ten times faster
+/// for position in Replay::new(File::open("flight.nmea")?, 10.0) {
+///     fms.update_position(&position?);
+/// }
+/// # Ok(())
+/// # }
+/// ```
+pub struct Replay<R> {
+    reader: NmeaReader<R>,
+    speed: f32,
+    start: Option<(Instant, OffsetDateTime)>,
+}
+
+impl<R: Read> Replay<R> {
+    /// Creates a replay of the NMEA log read from the `inner` reader.
+    ///
+    /// The `speed` is the factor by which the replay is accelerated, e.g. 1
+    /// for real time. An infinite speed replays the log without delay.
+    pub fn new(inner: R, speed: f32) -> Self {
+        Self {
+            reader: NmeaReader::new(inner),
+            speed,
+            start: None,
+        }
+    }
+
+    /// Returns the duration to wait from the start of the replay until the
+    /// position at the `time` is due.
+    fn due(&self, time: OffsetDateTime) -> Option<(Instant, Duration)> {
+        let (start, first) = self.start?;
+        let elapsed = (time - first).as_seconds_f32().max(0.0);
+        Some((start, Duration::from_secs_f32(elapsed / self.speed)))
+    }
+}
+
+impl<R: Read> Iterator for Replay<R> {
+    type Item = io::Result<Position>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        let position = match self.reader.next()? {
+            Ok(position) => position,
+            Err(e) => return Some(Err(e)),
+        };
+
+        if self.speed.is_finite() && self.speed > 0.0 {
+            match self.due(position.time) {
+                Some((start, due)) => {
+                    if let Some(wait) = due.checked_sub(start.elapsed()) {
+                        thread::sleep(wait);
+                    }
+                }
+                None => self.start = Some((Instant::now(), position.time)),
+            }
+        }
+
+        Some(Ok(position))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const LOG: &[u8] = b"$GPRMC,101500.00,A,5333.000,N,00958.000,E,100.0,045.0,181026,,*38
+$GPRMC,101501.00,A,5333.000,N,00958.000,E,100.0,045.0,181026,,*39
+$GPRMC,101502.00,A,5333.000,N,00958.000,E,100.0,045.0,181026,,*3A
+";
+
+    #[test]
+    fn accelerates_replay() {
+        let start = Instant::now();
+        assert_eq!(Replay::new(LOG, 20.0).count(), 3);
+
+        let elapsed = start.elapsed();
+        assert!(elapsed >= Duration::from_millis(100));
+        assert!(elapsed < Duration::from_secs(1));
+    }
+}
@@ -0,0 +1,460 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::mem;
+
+use time::OffsetDateTime;
+
+use super::Position;
+use crate::geom::Coordinate;
+use crate::measurements::{Duration, Length, Speed};
+use crate::route::{Route, Tracker};
+
+/// The number of bytes of deltas in a block.
+const BLOCK_SIZE: usize = 480;
+
+/// The longest delta of three zigzag encoded varints.
+const MAX_DELTA: usize = 30;
+
+/// The resolution of coordinates in units per degree, which is about 1 m.
+const UNITS_PER_DEGREE: f32 = 1e5;
+
+/// The resolution of times in nanoseconds per unit, which is a tenth of a
+/// second.
+const NANOS_PER_UNIT: i128 = 100_000_000;
+
+/// A recorded point of the track.
+#[derive(Copy, Clone, PartialEq, Debug)]
+pub struct TrackPoint {
+    pub coordinate: Coordinate,
+    pub time: OffsetDateTime,
+}
+
+/// A point quantized to time and angle units.
+#[derive(Copy, Clone, PartialEq, Debug)]
+struct Quantized {
+    time: i64,
+    lat: i32,
+    lon: i32,
+}
+
+/// A keyframe followed by the deltas of subsequent points.
+#[derive(Clone, Debug)]
+struct Block {
+    first: Quantized,
+    count: usize,
+    len: usize,
+    bytes: [u8; BLOCK_SIZE],
+}
+
+/// Recorder of the flown track.
+///
+/// The track is kept in a ring buffer of fixed memory which is allocated
+/// once. Points are quantized to a tenth of a second and about one meter and
+/// stored as varint deltas to the previous point, which takes about four
+/// bytes per point at 1 Hz. The buffer is split into blocks that start with
+/// an absolute point, and once the buffer is full the oldest block is
+/// overwritten.
+///
+/// # Examples
+///
+/// ```
+/// # use efb::gnss::{Position, TrackRecorder};
+/// # use efb::route::Route;
+/// # fn record(positions: &[Position], route: &Route) {
+/// // ten hours at 1 Hz
+/// let mut recorder = TrackRecorder::new(160 * 1024);
+/// for position in positions {
+///     recorder.record(position);
+/// }
+///
+/// for leg in recorder.compare(route) {
+///     println!("{:?} vs. {:?} max. XTE {}", leg.planned, leg.actual(), leg.max_xte);
+/// }
+/// # }
+/// ```
+#[derive(Clone, Debug)]
+pub struct TrackRecorder {
+    blocks: Vec<Block>,
+    /// The number of blocks that fit into the capacity.
+    block_count: usize,
+    /// The index of the oldest block.
+    oldest: usize,
+    /// The index of the block to which points are recorded.
+    current: usize,
+    last: Option<Quantized>,
+    len: usize,
+}
+
+/// A leg of the route as it was flown.
+#[derive(Copy, Clone, PartialEq, Debug)]
+pub struct FlownLeg {
+    /// The time at which the leg became active.
+    pub start: OffsetDateTime,
+    /// The time at which the leg was sequenced or `None` if the track ends on
+    /// the leg.
+    pub end: Option<OffsetDateTime>,
+    /// The planned estimated time enroute.
+    pub planned: Option<Duration>,
+    /// The largest cross-track error to either side of the leg.
+    pub max_xte: Length,
+    /// The mean cross-track error to either side of the leg.
+    pub mean_xte: Length,
+}
+
+impl TrackRecorder {
+    /// Creates a recorder that takes up about `capacity` bytes.
+    pub fn new(capacity: usize) -> Self {
+        let block_count = (capacity / mem::size_of::<Block>()).max(1);
+        Self {
+            blocks: Vec::with_capacity(block_count),
+            block_count,
+            oldest: 0,
+            current: 0,
+            last: None,
+            len: 0,
+        }
+    }
+
+    /// Records the `position`.
+    pub fn record(&mut self, position: &Position) {
+        let point = Quantized::new(&position.coordinate, position.time);
+
+        match self.last {
+            Some(last) if self.blocks[self.current].len + MAX_DELTA <= BLOCK_SIZE => {
+                let block = &mut self.blocks[self.current];
+                for delta in [
+                    point.time - last.time,
+                    (point.lat - last.lat) as i64,
+                    (point.lon - last.lon) as i64,
+                ] {
+                    block.len += write_varint(&mut block.bytes[block.len..], delta);
+                }
+                block.count += 1;
+            }
+            _ => self.start_block(point),
+        }
+
+        self.last = Some(point);
+        self.len += 1;
+    }
+
+    /// Returns the number of recorded points.
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Removes all points.
+    pub fn clear(&mut self) {
+        self.blocks.clear();
+        self.oldest = 0;
+        self.current = 0;
+        self.last = None;
+        self.len = 0;
+    }
+
+    /// Returns the recorded points from the oldest to the latest.
+    pub fn points(&self) -> impl Iterator<Item = TrackPoint> + '_ {
+        let (newer, older) = self.blocks.split_at(self.oldest);
+        older.iter().chain(newer).flat_map(Block::points)
+    }
+
+    /// Compares the track with the planned `route`.
+    ///
+    /// The track is aligned to the legs in a single pass by sequencing the
+    /// legs as in flight, starting with the first leg at the oldest point.
+    /// Returns the legs that were flown up to the end of the track.
+    pub fn compare(&self, route: &Route) -> Vec<FlownLeg> {
+        let mut tracker = Tracker::new(route);
+        let mut flown: Vec<FlownLeg> = Vec::new();
+        let (mut sum, mut n) = (0.0, 0);
+
+        for point in self.points() {
+            let Some(active) = tracker.active() else {
+                break;
+            };
+
+            if flown.is_empty() {
+                flown.push(FlownLeg::new(route, active, point.time));
+            }
+
+            if tracker.update(&point.coordinate, Speed::kt(0.0), point.time) {
+                let next = tracker.active().unwrap_or(route.legs().len());
+                // legs that were skipped between two points are entered and
+                // left at the same time
+                for i in active..next {
+                    flown[i].finish(point.time, sum, n);
+                    (sum, n) = (0.0, 0);
+                    if i + 1 < next {
+                        flown.push(FlownLeg::new(route, i + 1, point.time));
+                    }
+                }
+
+                if next < route.legs().len() {
+                    flown.push(FlownLeg::new(route, next, point.time));
+                } else {
+                    break;
+                }
+            }
+
+            let xte = tracker.xte().value().abs();
+            let leg = flown.last_mut().expect("leg should be entered");
+            leg.max_xte = Length::nm(leg.max_xte.value().max(xte));
+            sum += xte;
+            n += 1;
+        }
+
+        if let Some(leg) = flown.last_mut().filter(|leg| leg.end.is_none()) {
+            leg.mean_xte = mean(sum, n);
+        }
+
+        flown
+    }
+
+    fn start_block(&mut self, first: Quantized) {
+        let block = Block {
+            first,
+            count: 1,
+            len: 0,
+            bytes: [0; BLOCK_SIZE],
+        };
+
+        if self.blocks.len() < self.block_count {
+            self.current = self.blocks.len();
+            self.blocks.push(block);
+        } else {
+            // overwrite the oldest block
+            self.current = self.oldest;
+            self.oldest = (self.oldest + 1) % self.blocks.len();
+            self.len -= self.blocks[self.current].count;
+            self.blocks[self.current] = block;
+        }
+    }
+}
+
+impl Quantized {
+    fn new(coordinate: &Coordinate, time: OffsetDateTime) -> Self {
+        Self {
+            // rounded to the nearest unit
+            time: (time.unix_timestamp_nanos() + NANOS_PER_UNIT / 2).div_euclid(NANOS_PER_UNIT)
+                as i64,
+            lat: (coordinate.latitude * UNITS_PER_DEGREE).round() as i32,
+            lon: (coordinate.longitude * UNITS_PER_DEGREE).round() as i32,
+        }
+    }
+
+    fn point(&self) -> TrackPoint {
+        let nanos = self.time as i128 * NANOS_PER_UNIT;
+        TrackPoint {
+            coordinate: Coordinate::new(
+                self.lat as f32 / UNITS_PER_DEGREE,
+                self.lon as f32 / UNITS_PER_DEGREE,
+            ),
+            time: OffsetDateTime::from_unix_timestamp_nanos(nanos)
+                .unwrap_or(OffsetDateTime::UNIX_EPOCH),
+        }
+    }
+}
+
+impl Block {
+    fn points(&self) -> impl Iterator<Item = TrackPoint> + '_ {
+        let mut bytes = &self.bytes[..self.len];
+        let mut point = self.first;
+
+        (0..self.count).map(move |i| {
+            if i > 0 {
+                point.time += read_varint(&mut bytes);
+                point.lat += read_varint(&mut bytes) as i32;
+                point.lon += read_varint(&mut bytes) as i32;
+            }
+            point.point()
+        })
+    }
+}
+
+impl FlownLeg {
+    fn new(route: &Route, i: usize, start: OffsetDateTime) -> Self {
+        Self {
+            start,
+            end: None,
+            planned: route.legs()[i].ete().copied(),
+            max_xte: Length::nm(0.0),
+            mean_xte: Length::nm(0.0),
+        }
+    }
+
+    fn finish(&mut self, end: OffsetDateTime, sum: f32, n: usize) {
+        self.end = Some(end);
+        self.mean_xte = mean(sum, n);
+    }
+
+    /// The actual time enroute of the leg if it was sequenced.
+    pub fn actual(&self) -> Option<Duration> {
+        let ete = self.end? - self.start;
+        Some(Duration::s(ete.whole_seconds().max(0) as u32))
+    }
+}
+
+fn mean(sum: f32, n: usize) -> Length {
+    Length::nm(if n > 0 { sum / n as f32 } else { 0.0 })
+}
+
+/// Writes the zigzag encoded `value` as varint and returns the number of
+/// bytes written.
+fn write_varint(bytes: &mut [u8], value: i64) -> usize {
+    let mut v = ((value << 1) ^ (value >> 63)) as u64;
+    let mut i = 0;
+    while v >= 0x80 {
+        bytes[i] = (v as u8) | 0x80;
+        v >>= 7;
+        i += 1;
+    }
+    bytes[i] = v as u8;
+    i + 1
+}
+
+/// Reads a zigzag encoded varint and advances the `bytes`.
+fn read_varint(bytes: &mut &[u8]) -> i64 {
+    let mut v = 0u64;
+    let mut shift = 0;
+    while let Some((&b, rest)) = bytes.split_first() {
+        *bytes = rest;
+        v |= ((b & 0x7f) as u64) << shift;
+        if b & 0x80 == 0 {
+            break;
+        }
+        shift += 7;
+    }
+    ((v >> 1) as i64) ^ -((v & 1) as i64)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::fixtures;
+    use crate::nd::Fix;
+
+    fn position(i: i64) -> Position {
+        Position {
+            coordinate: Coordinate::new(53.5 + i as f32 * 0.0005, 10.0 - i as f32 * 0.0002),
+            time: OffsetDateTime::UNIX_EPOCH + time::Duration::seconds(1_800_000_000 + i),
+            gs: Speed::kt(100.0),
+            track: None,
+            altitude: None,
+        }
+    }
+
+    #[test]
+    fn round_trips_varints() {
+        let mut buf = [0; 10];
+        for value in [0, 1, -1, 63, -64, 64, 1 << 40, i64::MIN, i64::MAX] {
+            let n = write_varint(&mut buf, value);
+            let mut bytes = &buf[..n];
+            assert_eq!(read_varint(&mut bytes), value);
+            assert!(bytes.is_empty());
+        }
+    }
+
+    #[test]
+    fn records_delta_encoded_points() {
+        let mut recorder = TrackRecorder::new(64 * 1024);
+        for i in 0..1000 {
+            recorder.record(&position(i));
+        }
+
+        assert_eq!(recorder.len(), 1000);
+        // a keyframe every block and deltas of three bytes
+        assert!(recorder.blocks.len() <= 1000 * 3 / BLOCK_SIZE + 1);
+
+        for (i, point) in recorder.points().enumerate() {
+            let expected = position(i as i64);
+            assert_eq!(point.time, expected.time);
+            assert!((point.coordinate.latitude - expected.coordinate.latitude).abs() < 1e-5);
+            assert!((point.coordinate.longitude - expected.coordinate.longitude).abs() < 1e-5);
+        }
+    }
+
+    #[test]
+    fn overwrites_oldest_points() {
+        let mut recorder = TrackRecorder::new(2 * mem::size_of::<Block>());
+        for i in 0..2000 {
+            recorder.record(&position(i));
+        }
+
+        assert_eq!(recorder.blocks.len(), 2);
+        assert_eq!(recorder.points().count(), recorder.len());
+        assert_eq!(
+            recorder.points().last().map(|p| p.time),
+            Some(position(1999).time)
+        );
+
+        let times: Vec<_> = recorder.points().map(|p| p.time).collect();
+        assert!(times.windows(2).all(|w| w[0] < w[1]));
+    }
+
+    #[test]
+    fn quantizes_time_to_tenths_of_seconds() {
+        let time = position(0).time + time::Duration::milliseconds(1_234);
+        let point = Quantized::new(&Coordinate::new(53.5, 10.0), time).point();
+        assert_eq!(
+            point.time,
+            position(0).time + time::Duration::milliseconds(1_200)
+        );
+    }
+
+    #[test]
+    fn compares_track_with_route() {
+        let route = fixtures::route("13509KT N0107 EDDH ABBEN UL126 DELTA EDHF");
+        let mut recorder = TrackRecorder::new(16 * 1024);
+        let mut time = OffsetDateTime::UNIX_EPOCH;
+
+        // fly each leg in 60 seconds
+        for leg in route.legs() {
+            let (from, to) = (leg.from().coordinate(), leg.to().coordinate());
+            for i in 0..60 {
+                let f = i as f32 / 60.0;
+                let position = Position {
+                    coordinate: Coordinate::new(
+                        from.latitude + (to.latitude - from.latitude) * f,
+                        from.longitude + (to.longitude - from.longitude) * f,
+                    ),
+                    time,
+                    gs: Speed::kt(100.0),
+                    track: None,
+                    altitude: None,
+                };
+                recorder.record(&position);
+                time += time::Duration::seconds(1);
+            }
+        }
+
+        let flown = recorder.compare(&route);
+        assert_eq!(flown.len(), route.legs().len());
+
+        for (leg, planned) in flown.iter().zip(route.legs()).take(4) {
+            assert_eq!(leg.planned, planned.ete().copied());
+            assert!((59..=61).contains(&leg.actual().expect("leg should be sequenced").to_si()));
+            assert!(*leg.max_xte.value() < 0.5);
+            assert!(leg.mean_xte.value() <= leg.max_xte.value());
+        }
+
+        // the track ends before the destination
+        assert_eq!(flown[4].end, None);
+    }
+}
@@ -113,10 +113,14 @@ pub mod fc;
 pub mod fms;
 pub mod fp;
 pub mod geom;
+pub mod gnss;
 pub mod measurements;
 pub mod nd;
 pub mod route;
 
+#[cfg(test)]
+mod fixtures;
+
 pub mod prelude {
     pub use crate::aircraft::{Aircraft, AircraftBuilder, CGLimit, FuelTank, Station};
     pub use crate::core::{Fuel, FuelFlow, FuelType, VerticalDistance};
@@ -13,9 +13,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+use std::cmp::Ordering;
 use std::fmt;
+use std::sync::OnceLock;
 
-use chrono::{Datelike, Duration, NaiveDate, Weekday};
+use chrono::{Datelike, Duration, NaiveDate};
 use time::OffsetDateTime;
 
 #[cfg(feature = "serde")]
@@ -26,6 +28,38 @@ use serde::{Deserialize, Serialize};
 const REFERENCE_DATE: NaiveDate =
     NaiveDate::from_ymd_opt(2019, 1, 3).expect("2019-01-03 should be a valid date");
 
+/// The first year of the calendar.
+const FIRST_YEAR: i32 = 2000;
+
+/// The number of years within the calendar, which are all years that can be
+/// stated by the two digits of a cycle.
+const YEARS: usize = 100;
+
+/// Returns the effective date of the first cycle of each year of the
+/// calendar and of the year after.
+///
+/// The calendar is built once, thus, looking up the dates of a cycle or the
+/// cycle of a date doesn't need to align the year to the 28-day pattern
+/// again.
+fn calendar() -> &'static [NaiveDate; YEARS + 1] {
+    static CALENDAR: OnceLock<[NaiveDate; YEARS + 1]> = OnceLock::new();
+
+    CALENDAR.get_or_init(|| {
+        std::array::from_fn(|i| {
+            let new_year = NaiveDate::from_ymd_opt(FIRST_YEAR + i as i32, 1, 1)
+                .expect("the year should be before 262143 CE");
+
+            // align with the 28-day AIRAC cycle pattern
+            let offset = (new_year - REFERENCE_DATE).num_days().rem_euclid(28);
+            if offset == 0 {
+                new_year
+            } else {
+                new_year + Duration::days(28 - offset)
+            }
+        })
+    })
+}
+
 #[derive(Copy, Clone, Eq, PartialEq, Hash, Debug)]
 #[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
 pub enum CycleValidity {
@@ -56,40 +90,40 @@ impl AiracCycle {
         Self { year, cycle }
     }
 
-    /// Calculates the effective date when this AIRAC cycle starts.
+    /// Returns the cycle that is effective at the `date`.
     ///
-    /// Returns `None` if the calculated date is either to far in the future or
-    /// past.
-    pub fn effective_date(&self) -> Option<NaiveDate> {
-        // now we need to get the first Thursday of the year
-        let year = self.year as u16 + 2000u16; // TODO: Please update in the year 3000...
-        let first_thu = NaiveDate::from_weekday_of_month_opt(year as i32, 1, Weekday::Thu, 1)
-            .expect("the year should be before before 262143 CE");
-
-        // align with the 28-day AIRAC cycle pattern
-        let days_since_ref = (first_thu - REFERENCE_DATE).num_days();
-        let cycle_offset = days_since_ref % 28;
-
-        let first_airac_of_year = if cycle_offset == 0 {
-            first_thu
-        } else {
-            first_thu + Duration::days(28 - cycle_offset)
-        };
-
-        // calculate the target cycle date
-        let target_date = first_airac_of_year + Duration::days(28 * (self.cycle - 1) as i64);
-
-        // verify the date makes sense (not too far into the future/past)
-        if target_date.year() as u16 == year
-            || (self.cycle == 1 && target_date.year() as u16 == year - 1)
-        {
-            Some(target_date)
-        } else {
-            None
+    /// Returns `None` if the date is before 2000 or after 2099.
+    pub fn at(date: NaiveDate) -> Option<Self> {
+        let calendar = calendar();
+        let mut year = usize::try_from(date.year() - FIRST_YEAR).ok()?;
+        if year >= YEARS {
+            return None;
+        }
+
+        // the first days of a year might belong to the last cycle of the
+        // previous year
+        if date < calendar[year] {
+            year = year.checked_sub(1)?;
         }
+
+        let cycle = (date - calendar[year]).num_days() / 28 + 1;
+        Some(Self::new(year as u8, cycle as u8))
+    }
+
+    /// Returns the effective date when this AIRAC cycle starts.
+    ///
+    /// Returns `None` if the cycle doesn't exist within its year or the year
+    /// is after 2099.
+    pub fn effective_date(&self) -> Option<NaiveDate> {
+        let calendar = calendar();
+        let year = self.year as usize;
+        let (start, next_year) = (calendar.get(year)?, calendar.get(year + 1)?);
+
+        let date = *start + Duration::days(28 * self.cycle.checked_sub(1)? as i64);
+        (date < *next_year).then_some(date)
     }
 
-    /// Calculates the end date when this AIRAC cycle expires
+    /// Returns the end date when this AIRAC cycle expires.
     ///
     /// Returns `None` if the effective date is invalid.
     pub fn end_date(&self) -> Option<NaiveDate> {
@@ -101,34 +135,54 @@ impl AiracCycle {
     ///
     /// Returns `None` if the effective date is invalid.
     pub fn valid_for_date(&self, date: NaiveDate) -> Option<CycleValidity> {
-        let start_date = self.effective_date()?;
-        let end_date = self.end_date()?;
-
-        if date < start_date {
-            Some(CycleValidity::Future)
-        } else if date > end_date {
-            Some(CycleValidity::Expired)
-        } else {
-            Some(CycleValidity::Valid)
-        }
+        self.effective_date()?;
+        Some(self.validity(AiracCycle::at(date), date))
     }
 
     /// Checks if the cycle is now valid with reference to the UTC date.
     ///
     /// Returns `None` if the effective date is invalid.
     pub fn now_valid(&self) -> Option<CycleValidity> {
-        let now = OffsetDateTime::now_utc().date();
-        let y = now.year();
-        let m: u8 = now.month().into();
-        let d = now.day();
+        self.valid_for_date(today())
+    }
 
-        let date =
-            NaiveDate::from_ymd_opt(y, m as u32, d as u32).expect("now should be a valid date");
+    /// Checks all `cycles` for the `date`, e.g. the cycles of all records of
+    /// navigation data.
+    ///
+    /// The cycle of the date is looked up once and each cycle is then only
+    /// compared to it. A `None` cycle or a cycle without a valid effective
+    /// date yields `None`.
+    pub fn validate_all<'a>(
+        cycles: impl IntoIterator<Item = Option<&'a AiracCycle>> + 'a,
+        date: NaiveDate,
+    ) -> impl Iterator<Item = Option<CycleValidity>> + 'a {
+        let current = AiracCycle::at(date);
+        cycles.into_iter().map(move |cycle| {
+            let cycle = cycle?;
+            cycle.effective_date()?;
+            Some(cycle.validity(current, date))
+        })
+    }
 
-        self.valid_for_date(date)
+    /// Returns the validity compared to the `current` cycle of the `date`.
+    fn validity(&self, current: Option<AiracCycle>, date: NaiveDate) -> CycleValidity {
+        match current.map(|current| self.cmp(&current)) {
+            Some(Ordering::Equal) => CycleValidity::Valid,
+            Some(Ordering::Greater) => CycleValidity::Future,
+            Some(Ordering::Less) => CycleValidity::Expired,
+            // the date is outside of the calendar
+            None if date.year() < FIRST_YEAR => CycleValidity::Future,
+            None => CycleValidity::Expired,
+        }
     }
 }
 
+/// Returns the current UTC date.
+fn today() -> NaiveDate {
+    let now = OffsetDateTime::now_utc().date();
+    NaiveDate::from_yo_opt(now.year(), now.ordinal() as u32).expect("now should be a valid date")
+}
+
 impl fmt::Display for AiracCycle {
     fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
         write!(f, "{:02}{:02}", self.year, self.cycle)
@@ -164,6 +218,60 @@ mod tests {
         );
     }
 
+    #[test]
+    fn test_cycle_at_date() {
+        let date = |y, m, d| NaiveDate::from_ymd_opt(y, m, d).expect("date should be valid");
+
+        assert_eq!(
+            AiracCycle::at(date(2025, 9, 4)),
+            Some(AiracCycle::new(25, 9))
+        );
+        assert_eq!(
+            AiracCycle::at(date(2025, 10, 1)),
+            Some(AiracCycle::new(25, 9))
+        );
+        // 2020 has 14 cycles and its last one lasts into 2021
+        assert_eq!(
+            AiracCycle::at(date(2021, 1, 27)),
+            Some(AiracCycle::new(20, 14))
+        );
+        assert_eq!(
+            AiracCycle::at(date(2021, 1, 28)),
+            Some(AiracCycle::new(21, 1))
+        );
+        assert_eq!(AiracCycle::at(date(1999, 12, 31)), None);
+
+        // every cycle is effective at its own effective date
+        for cycle in (0..99).flat_map(|year| (1..=14).map(move |c| AiracCycle::new(year, c))) {
+            if let Some(effective) = cycle.effective_date() {
+                assert_eq!(AiracCycle::at(effective), Some(cycle));
+            }
+        }
+    }
+
+    #[test]
+    fn test_validate_all() {
+        let date = NaiveDate::from_ymd_opt(2025, 9, 18).expect("2025-09-18 should be a valid date");
+        let cycles = [
+            Some(AiracCycle::new(25, 8)),
+            Some(AiracCycle::new(25, 9)),
+            Some(AiracCycle::new(25, 10)),
+            Some(AiracCycle::new(25, 15)),
+            None,
+        ];
+
+        assert_eq!(
+            AiracCycle::validate_all(cycles.iter().map(Option::as_ref), date).collect::<Vec<_>>(),
+            vec![
+                Some(CycleValidity::Expired),
+                Some(CycleValidity::Valid),
+                Some(CycleValidity::Future),
+                None,
+                None
+            ]
+        );
+    }
+
     #[test]
     fn test_identifier_format() {
         let cycle = AiracCycle::new(25, 9);
@@ -43,4 +43,10 @@ impl Fix for Airport {
     fn coordinate(&self) -> Coordinate {
         self.coordinate
     }
+
+    /// Returns the stated magnetic variation or the declination at the epoch
+    /// of the data the airport is loaded from.
+    fn mag_var(&self) -> MagneticVariation {
+        self.mag_var
+    }
 }
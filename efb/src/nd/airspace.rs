@@ -13,12 +13,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+use std::borrow::Borrow;
+use std::collections::HashMap;
 use std::fmt::{Display, Formatter, Result};
 
 #[cfg(feature = "serde")]
 use serde::{Deserialize, Serialize};
 
-use crate::geom::Polygon;
+use crate::algorithm::{self, Point};
+use crate::geom::{BBox, CellId, Coordinate, Corridor, Polygon};
+use crate::measurements::{Duration, Length};
 use crate::VerticalDistance;
 
 pub type Airspaces = Vec<Airspace>;
@@ -82,3 +86,343 @@ impl Display for Airspace {
         )
     }
 }
+
+/// An airspace that is entered or skirted ahead on the track.
+#[derive(Clone, PartialEq, Debug)]
+pub struct AirspaceEntry<'a> {
+    pub airspace: &'a Airspace,
+    /// The along-track distance to where the airspace's boundary is crossed
+    /// or, if the airspace is only skirted, comes closest to the track.
+    pub dist: Length,
+    /// The closest distance between the track and the airspace's boundary,
+    /// which is zero if the airspace is entered.
+    pub clearance: Length,
+    /// The time until the along-track distance is flown or `None` if not
+    /// moving.
+    pub ete: Option<Duration>,
+}
+
+/// The level of the cells that index the airspaces, which are about 1.4°
+/// wide and 0.7° high.
+const LEVEL: u8 = 8;
+
+/// The geometry of airspaces in flat columns.
+///
+/// The vertices of all polygons are kept one after another in a single
+/// buffer with the offset of each polygon, next to columns of the bounds,
+/// class, floor and ceiling of each airspace. Queries stream through the
+/// columns linearly and check the vertices only of airspaces whose bounds
+/// match. Queries of a point or a short track, e.g. on each position update,
+/// visit only the airspaces of the [cells] that cover it.
+///
+/// [cells]: CellId
+#[derive(Clone, Debug, Default)]
+pub(crate) struct AirspaceGeometry {
+    vertices: Vec<Point>,
+    offsets: Vec<u32>,
+    // south, west, north and east bound of each airspace
+    bounds: Vec<[f32; 4]>,
+    classes: Vec<AirspaceClass>,
+    floors: Vec<VerticalDistance>,
+    ceilings: Vec<VerticalDistance>,
+    cells: HashMap<CellId, Vec<u32>>,
+}
+
+impl AirspaceGeometry {
+    pub(crate) fn new<A: Borrow<Airspace>>(airspaces: &[A]) -> Self {
+        let airspaces = || airspaces.iter().map(Borrow::borrow);
+        let vertices_len = airspaces().map(|airspace| airspace.polygon.len()).sum();
+
+        let mut geometry = Self {
+            vertices: Vec::with_capacity(vertices_len),
+            offsets: Vec::with_capacity(airspaces().len() + 1),
+            bounds: Vec::with_capacity(airspaces().len()),
+            classes: airspaces().map(|airspace| airspace.class).collect(),
+            floors: airspaces().map(|airspace| airspace.floor).collect(),
+            ceilings: airspaces().map(|airspace| airspace.ceiling).collect(),
+            cells: HashMap::new(),
+        };
+
+        geometry.offsets.push(0);
+        for airspace in airspaces() {
+            // an empty polygon has bounds that contain nothing
+            let mut bounds = [f32::INFINITY, f32::INFINITY, -f32::INFINITY, -f32::INFINITY];
+
+            for coord in airspace.polygon.iter() {
+                bounds[0] = bounds[0].min(coord.latitude);
+                bounds[1] = bounds[1].min(coord.longitude);
+                bounds[2] = bounds[2].max(coord.latitude);
+                bounds[3] = bounds[3].max(coord.longitude);
+                geometry.vertices.push(point(coord));
+            }
+
+            let [south, west, north, east] = bounds;
+            let bbox = BBox::new(&[Coordinate::new(south, west), Coordinate::new(north, east)]);
+            if let Some(bbox) = bbox.filter(|_| !airspace.polygon.is_empty()) {
+                let i = geometry.bounds.len() as u32;
+                for cell in CellId::covering(&bbox, LEVEL) {
+                    geometry.cells.entry(cell).or_default().push(i);
+                }
+            }
+
+            geometry.offsets.push(geometry.vertices.len() as u32);
+            geometry.bounds.push(bounds);
+        }
+
+        geometry
+    }
+
+    /// Returns the indices of the airspaces that contain the `point`.
+    pub(crate) fn at<'a>(&'a self, point: &Coordinate) -> impl Iterator<Item = usize> + 'a {
+        let p = self::point(point);
+        self.cells
+            .get(&CellId::new(point, LEVEL))
+            .into_iter()
+            .flatten()
+            .map(|&i| i as usize)
+            .filter(move |&i| {
+                let [south, west, north, east] = self.bounds[i];
+                (south..=north).contains(&p.y) && (west..=east).contains(&p.x)
+            })
+            .filter(move |&i| self.contains(i, &p))
+    }
+
+    /// Returns the indices of the airspaces that are entered or touched by
+    /// the line from `from` to `to` and that range over the `level`.
+    pub(crate) fn crossing<'a>(
+        &'a self,
+        from: &Coordinate,
+        to: &Coordinate,
+        level: VerticalDistance,
+    ) -> impl Iterator<Item = usize> + 'a {
+        let (a, b) = (point(from), point(to));
+        let line = [a.y.min(b.y), a.x.min(b.x), a.y.max(b.y), a.x.max(b.x)];
+
+        self.matching(move |bounds| overlap(bounds, &line))
+            .filter(move |&i| self.floors[i] <= level && level <= self.ceilings[i])
+            .filter(move |&i| {
+                self.contains(i, &a)
+                    || self
+                        .polygon(i)
+                        .windows(2)
+                        .any(|edge| algorithm::segments_intersect((a, b), (edge[0], edge[1])))
+            })
+    }
+
+    /// Returns the index of each airspace at the `level` whose boundary
+    /// reaches into the `corridor` together with its [approach] to the
+    /// corridor's line.
+    ///
+    /// Only the airspaces of the cells that cover the corridor are visited.
+    ///
+    /// [approach]: AirspaceGeometry::approach
+    pub(crate) fn approaching(
+        &self,
+        corridor: &Corridor,
+        level: VerticalDistance,
+    ) -> Vec<(usize, f32, f32)> {
+        let bbox = [corridor.south, corridor.west, corridor.north, corridor.east];
+        let mut indices: Vec<usize> = CellId::covering(&corridor.bbox(), LEVEL)
+            .filter_map(|cell| self.cells.get(&cell))
+            .flatten()
+            .map(|&i| i as usize)
+            .collect();
+        // an airspace is within each cell that its bounds overlap
+        indices.sort_unstable();
+        indices.dedup();
+
+        indices
+            .into_iter()
+            .filter(|&i| overlap(&self.bounds[i], &bbox))
+            .filter(|&i| self.floors[i] <= level && level <= self.ceilings[i])
+            .filter_map(|i| {
+                self.approach(i, corridor)
+                    .map(|(along, dist)| (i, along, dist))
+            })
+            .filter(|&(_, _, dist)| dist <= corridor.radius)
+            .collect()
+    }
+
+    /// Returns the indices of the airspaces whose bounds overlap the `bbox`,
+    /// e.g. to select the airspaces of a map tile.
+    pub(crate) fn within<'a>(&'a self, bbox: &BBox) -> impl Iterator<Item = usize> + 'a {
+        let (sw, ne) = (bbox.sw(), bbox.ne());
+        let bbox = [sw.latitude, sw.longitude, ne.latitude, ne.longitude];
+        self.matching(move |bounds| overlap(bounds, &bbox))
+    }
+
+    /// Returns whether the airspace is of one of the `classes` or of any
+    /// class if none are given.
+    pub(crate) fn is_of(&self, i: usize, classes: &[AirspaceClass]) -> bool {
+        classes.is_empty() || classes.contains(&self.classes[i])
+    }
+
+    /// Returns the along-track distance at which the airspace comes closest
+    /// to the corridor's line and the distance between both, which is zero if
+    /// the line enters the airspace or starts within it.
+    pub(crate) fn approach(&self, i: usize, corridor: &Corridor) -> Option<(f32, f32)> {
+        let (lat, lon) = corridor.start();
+        if self.contains(i, &Point { x: lon, y: lat }) {
+            return Some((0.0, 0.0));
+        }
+
+        self.polygon(i)
+            .windows(2)
+            .map(|edge| corridor.locate_edge((edge[0].y, edge[0].x), (edge[1].y, edge[1].x)))
+            .min_by(|a, b| a.1.total_cmp(&b.1).then(a.0.total_cmp(&b.0)))
+    }
+
+    fn matching<'a>(
+        &'a self,
+        f: impl Fn(&[f32; 4]) -> bool + 'a,
+    ) -> impl Iterator<Item = usize> + 'a {
+        self.bounds
+            .iter()
+            .enumerate()
+            .filter(move |(_, bounds)| f(bounds))
+            .map(|(i, _)| i)
+    }
+
+    fn polygon(&self, i: usize) -> &[Point] {
+        &self.vertices[self.offsets[i] as usize..self.offsets[i + 1] as usize]
+    }
+
+    fn contains(&self, i: usize, p: &Point) -> bool {
+        let polygon = self.polygon(i);
+        !polygon.is_empty() && algorithm::winding_number(p, polygon) != 0
+    }
+}
+
+fn point(coord: &Coordinate) -> Point {
+    Point {
+        x: coord.longitude,
+        y: coord.latitude,
+    }
+}
+
+fn overlap(a: &[f32; 4], b: &[f32; 4]) -> bool {
+    a[0] <= b[2] && b[0] <= a[2] && a[1] <= b[3] && b[1] <= a[3]
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn airspaces() -> Vec<Airspace> {
+        let airspace = |name: &str, floor, polygon| Airspace {
+            name: String::from(name),
+            class: AirspaceClass::D,
+            ceiling: VerticalDistance::Fl(65),
+            floor,
+            polygon,
+        };
+
+        vec![
+            airspace(
+                "SQUARE",
+                VerticalDistance::Gnd,
+                polygon![
+                    (10.0, 10.0),
+                    (20.0, 10.0),
+                    (20.0, 20.0),
+                    (10.0, 20.0),
+                    (10.0, 10.0)
+                ],
+            ),
+            airspace("EMPTY", VerticalDistance::Gnd, Polygon::new()),
+            airspace(
+                "HIGH SQUARE",
+                VerticalDistance::Msl(4500),
+                polygon![
+                    (30.0, 10.0),
+                    (40.0, 10.0),
+                    (40.0, 20.0),
+                    (30.0, 20.0),
+                    (30.0, 10.0)
+                ],
+            ),
+        ]
+    }
+
+    #[test]
+    fn airspaces_at_point() {
+        let geometry = AirspaceGeometry::new(&airspaces());
+        assert_eq!(
+            geometry.at(&coord!(15.0, 15.0)).collect::<Vec<_>>(),
+            vec![0]
+        );
+        assert_eq!(geometry.at(&coord!(25.0, 15.0)).next(), None);
+    }
+
+    #[test]
+    fn airspaces_crossed_at_level() {
+        let geometry = AirspaceGeometry::new(&airspaces());
+        let crossing =
+            |from, to, level| -> Vec<usize> { geometry.crossing(&from, &to, level).collect() };
+
+        // the line passes through both squares without a vertex inside
+        let (from, to) = (coord!(5.0, 15.0), coord!(45.0, 15.0));
+        assert_eq!(crossing(from, to, VerticalDistance::Msl(5000)), vec![0, 2]);
+        assert_eq!(crossing(from, to, VerticalDistance::Msl(2000)), vec![0]);
+        assert_eq!(
+            crossing(
+                coord!(5.0, 25.0),
+                coord!(45.0, 25.0),
+                VerticalDistance::Msl(5000)
+            ),
+            Vec::<usize>::new()
+        );
+    }
+
+    #[test]
+    fn airspaces_approaching_corridor() {
+        let geometry = AirspaceGeometry::new(&airspaces());
+        let approaching = |from, to, radius| -> Vec<(usize, f32, f32)> {
+            geometry
+                .approaching(
+                    &Corridor::new(&from, &to, Length::nm(radius)),
+                    VerticalDistance::Msl(5000),
+                )
+                .into_iter()
+                .map(|(i, along, dist)| (i, along.round(), dist.round()))
+                .collect()
+        };
+
+        // the square is entered a degree or 60 NM north of the start
+        assert_eq!(
+            approaching(coord!(9.0, 15.0), coord!(11.0, 15.0), 1.0),
+            vec![(0, 60.0, 0.0)]
+        );
+
+        // the square's east edge passes about 58 NM west of the line
+        assert_eq!(
+            approaching(coord!(15.0, 21.0), coord!(16.0, 21.0), 60.0),
+            vec![(0, 0.0, 58.0)]
+        );
+        assert!(approaching(coord!(15.0, 21.0), coord!(16.0, 21.0), 50.0).is_empty());
+    }
+
+    #[test]
+    fn airspaces_within_bbox() {
+        let geometry = AirspaceGeometry::new(&airspaces());
+        let bbox =
+            BBox::new(&[coord!(18.0, 0.0), coord!(35.0, 12.0)]).expect("bbox should be some");
+        assert_eq!(geometry.within(&bbox).collect::<Vec<_>>(), vec![0, 2]);
+    }
+
+    #[test]
+    fn airspaces_of_classes() {
+        let mut airspaces = airspaces();
+        airspaces[2].class = AirspaceClass::C;
+        let geometry = AirspaceGeometry::new(&airspaces);
+
+        let of = |classes: &[AirspaceClass]| -> Vec<usize> {
+            (0..airspaces.len())
+                .filter(|&i| geometry.is_of(i, classes))
+                .collect()
+        };
+        assert_eq!(of(&[AirspaceClass::C]), vec![2]);
+        assert_eq!(of(&[AirspaceClass::C, AirspaceClass::D]), vec![0, 1, 2]);
+        assert_eq!(of(&[]), vec![0, 1, 2]);
+    }
+}
@@ -0,0 +1,598 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::collections::{BTreeMap, HashMap, HashSet};
+
+#[cfg(feature = "serde")]
+use serde::{Deserialize, Serialize};
+
+use super::merge::Resolution;
+use super::AiracCycle;
+
+/// The airway network.
+///
+/// Airways don't own their fixes but refer to them by the index into the
+/// waypoints of the navigation data. The fixes of all airways are stored in one
+/// array in which each airway spans a range in sequence order. Vice versa, the
+/// airways on which a fix is located are stored in a second array keyed by the
+/// fix index. Both arrays are in compressed sparse row (CSR) layout, thus, the
+/// network can be traversed as a graph from any fix without searching through
+/// all airways.
+#[derive(Clone, PartialEq, Debug, Default)]
+#[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
+pub struct Airways {
+    idents: Vec<String>,
+    areas: Vec<String>,
+    cycles: Vec<Option<AiracCycle>>,
+    /// The airways of an ident, since airways of different areas might share
+    /// an ident, e.g. A1.
+    lookup: HashMap<String, Vec<u32>>,
+    /// The fixes of airway `i` are `fixes[offsets[i]..offsets[i + 1]]`.
+    offsets: Vec<u32>,
+    fixes: Vec<u32>,
+    /// The sequence number of each fix as stated by the records.
+    seqs: Vec<u32>,
+    /// The airways of fix `f` are `positions[fix_offsets[f]..fix_offsets[f + 1]]`.
+    fix_offsets: Vec<u32>,
+    positions: Vec<AirwayPosition>,
+}
+
+/// An airway given by its ident, the customer area that defines it, the
+/// newest cycle of its records and the sequence number and index of each fix
+/// in sequence order.
+#[derive(Clone, PartialEq, Debug)]
+pub(crate) struct Airway {
+    pub(crate) ident: String,
+    pub(crate) area: String,
+    pub(crate) cycle: Option<AiracCycle>,
+    pub(crate) fixes: Vec<(u32, u32)>,
+}
+
+impl Airway {
+    /// Merges the fixes of `other` into this airway of the same ident and area
+    /// and returns `true` if both state different fixes at a sequence number
+    /// while being of the same cycle.
+    ///
+    /// The fixes are united by their sequence number, thus, the parts of an
+    /// airway that are stated by different data, e.g. by the data of two
+    /// countries, are joined. A fix that differs at a sequence number is
+    /// taken from the airway of the newer cycle, which also takes precedence
+    /// if a fix moved to another sequence number.
+    fn merge(&mut self, other: Airway) -> bool {
+        let resolution = Resolution::new(self.cycle, other.cycle);
+        let mut conflict = false;
+
+        if resolution == Resolution::Replace {
+            let moved: HashSet<u32> = other.fixes.iter().map(|&(_, fix)| fix).collect();
+            self.fixes
+                .retain(|(seq, fix)| !moved.contains(fix) || other.fixes.contains(&(*seq, *fix)));
+        }
+
+        let mut fixes: BTreeMap<u32, u32> = self.fixes.iter().copied().collect();
+        for (seq, fix) in other.fixes {
+            let ours = fixes.entry(seq).or_insert(fix);
+            if *ours != fix {
+                match resolution {
+                    Resolution::Replace => *ours = fix,
+                    Resolution::Conflict => conflict = true,
+                    Resolution::Keep => {}
+                }
+            }
+        }
+
+        self.fixes = fixes.into_iter().collect();
+        self.cycle = self.cycle.max(other.cycle);
+        conflict
+    }
+
+    /// Returns the first and last sequence number of the fixes.
+    fn range(&self) -> (u32, u32) {
+        let first = self.fixes.first().map_or(0, |&(seq, _)| seq);
+        let last = self.fixes.last().map_or(0, |&(seq, _)| seq);
+        (first, last)
+    }
+
+    /// Returns the number of sequence numbers between this and the `other`
+    /// airway, which is zero if their ranges overlap.
+    fn gap(&self, other: &Airway) -> u32 {
+        let (a, b) = (self.range(), other.range());
+        b.0.saturating_sub(a.1).max(a.0.saturating_sub(b.1))
+    }
+}
+
+/// The position of a fix on an airway.
+#[derive(Copy, Clone, Eq, PartialEq, Hash, Debug)]
+#[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
+pub struct AirwayPosition {
+    airway: u32,
+    seq: u32,
+}
+
+impl AirwayPosition {
+    /// The index of the airway.
+    pub fn airway(&self) -> usize {
+        self.airway as usize
+    }
+
+    /// The position of the fix within the airway's sequence.
+    pub fn seq(&self) -> usize {
+        self.seq as usize
+    }
+}
+
+impl Airways {
+    /// Creates the network from the `airways`. The fix indices must be less
+    /// than `fix_count`.
+    pub(crate) fn new<I>(airways: I, fix_count: usize) -> Self
+    where
+        I: IntoIterator<Item = Airway>,
+    {
+        let mut network = Self {
+            offsets: vec![0],
+            ..Self::default()
+        };
+
+        for airway in airways {
+            let index = network.idents.len() as u32;
+            network
+                .lookup
+                .entry(airway.ident.clone())
+                .or_default()
+                .push(index);
+            network.idents.push(airway.ident);
+            network.areas.push(airway.area);
+            network.cycles.push(airway.cycle);
+            for (seq, fix) in airway.fixes {
+                network.seqs.push(seq);
+                network.fixes.push(fix);
+            }
+            network.offsets.push(network.fixes.len() as u32);
+        }
+
+        // count the airways per fix and accumulate them to the offsets
+        let mut fix_offsets = vec![0u32; fix_count + 1];
+        for &fix in &network.fixes {
+            fix_offsets[fix as usize + 1] += 1;
+        }
+        for i in 1..fix_offsets.len() {
+            fix_offsets[i] += fix_offsets[i - 1];
+        }
+
+        let mut cursor = fix_offsets.clone();
+        let mut positions = vec![AirwayPosition { airway: 0, seq: 0 }; network.fixes.len()];
+        for airway in 0..network.idents.len() {
+            for (seq, &fix) in network.airway_fixes(airway).iter().enumerate() {
+                let i = &mut cursor[fix as usize];
+                positions[*i as usize] = AirwayPosition {
+                    airway: airway as u32,
+                    seq: seq as u32,
+                };
+                *i += 1;
+            }
+        }
+
+        network.fix_offsets = fix_offsets;
+        network.positions = positions;
+        network
+    }
+
+    /// Returns the number of airways.
+    pub fn len(&self) -> usize {
+        self.idents.len()
+    }
+
+    /// Returns `true` if there are no airways.
+    pub fn is_empty(&self) -> bool {
+        self.idents.is_empty()
+    }
+
+    /// Returns the indices of the airways with the `ident`.
+    ///
+    /// Airways of different areas might share an ident, thus, more than one
+    /// airway might be returned.
+    pub fn find(&self, ident: &str) -> impl Iterator<Item = usize> + '_ {
+        self.lookup
+            .get(ident)
+            .into_iter()
+            .flatten()
+            .map(|&i| i as usize)
+    }
+
+    /// Returns the ident of the `airway`.
+    pub fn ident(&self, airway: usize) -> &str {
+        &self.idents[airway]
+    }
+
+    /// Returns the customer area of the `airway`, e.g. `EUR`.
+    pub fn area(&self, airway: usize) -> &str {
+        &self.areas[airway]
+    }
+
+    /// Returns the fix indices of the `airway` in sequence order.
+    pub fn fixes(&self, airway: usize) -> impl Iterator<Item = usize> + '_ {
+        self.airway_fixes(airway).iter().map(|&fix| fix as usize)
+    }
+
+    /// Returns the positions of the `fix` on all airways it is located on.
+    pub fn positions(&self, fix: usize) -> &[AirwayPosition] {
+        match (self.fix_offsets.get(fix), self.fix_offsets.get(fix + 1)) {
+            (Some(&start), Some(&end)) => &self.positions[start as usize..end as usize],
+            _ => &[],
+        }
+    }
+
+    /// Returns the fixes that are connected to the `fix` by an airway together
+    /// with the index of that airway.
+    pub fn neighbours(&self, fix: usize) -> impl Iterator<Item = (usize, usize)> + '_ {
+        self.positions(fix).iter().flat_map(move |pos| {
+            let fixes = self.airway_fixes(pos.airway());
+            let prev = pos.seq().checked_sub(1).map(|seq| fixes[seq]);
+            let next = fixes.get(pos.seq() + 1).copied();
+            prev.into_iter()
+                .chain(next)
+                .map(move |fix| (fix as usize, pos.airway()))
+        })
+    }
+
+    /// Returns the fixes on the `airway` going from the fix at sequence
+    /// position `from` to the one at `to`.
+    ///
+    /// The `from` fix is excluded but the `to` fix is included. The airway can
+    /// be flown in both directions, thus, `to` might be before `from`.
+    pub fn segment(&self, airway: usize, from: usize, to: usize) -> Vec<usize> {
+        let fixes = self.airway_fixes(airway);
+
+        if from <= to {
+            fixes[from + 1..=to]
+                .iter()
+                .map(|&fix| fix as usize)
+                .collect()
+        } else {
+            fixes[to..from]
+                .iter()
+                .rev()
+                .map(|&fix| fix as usize)
+                .collect()
+        }
+    }
+
+    /// Appends the `other` airways whose fix indices are shifted by the
+    /// `fix_offset` into a network with `fix_count` fixes.
+    pub(crate) fn append(&mut self, other: Airways, fix_offset: usize, fix_count: usize) {
+        let airways: Vec<Airway> = (0..self.len())
+            .map(|airway| self.airway(airway))
+            .chain((0..other.len()).map(|airway| {
+                let mut airway = other.airway(airway);
+                airway
+                    .fixes
+                    .iter_mut()
+                    .for_each(|(_, fix)| *fix += fix_offset as u32);
+                airway
+            }))
+            .collect();
+
+        *self = Self::new(airways, fix_count);
+    }
+
+    /// Merges the `other` airways into this network of `fix_count` fixes and
+    /// returns the idents of conflicting airways.
+    ///
+    /// The fixes of the other airways are mapped by `remap`. An airway whose
+    /// ident and area are already within the network is united with the
+    /// existing one by the sequence numbers of their fixes, where the airway
+    /// of the newer cycle wins if both state different fixes. Airways that
+    /// differ but are of the same cycle are reported as conflict.
+    ///
+    /// An airway that is split into parts at removed fixes is united with
+    /// the parts whose sequence numbers overlap, thus, reloading the removed
+    /// fixes joins the parts again. An airway that overlaps no part is united
+    /// with the nearest one.
+    pub(crate) fn merge(
+        &mut self,
+        other: Airways,
+        remap: impl Fn(u32) -> u32,
+        fix_count: usize,
+    ) -> Vec<String> {
+        let mut airways: Vec<Airway> = (0..self.len()).map(|airway| self.airway(airway)).collect();
+        let mut parts: HashMap<(String, String), Vec<usize>> = HashMap::new();
+        for (i, airway) in airways.iter().enumerate() {
+            parts
+                .entry((airway.ident.clone(), airway.area.clone()))
+                .or_default()
+                .push(i);
+        }
+        let mut conflicts = Vec::new();
+
+        for airway in 0..other.len() {
+            let mut airway = other.airway(airway);
+            airway
+                .fixes
+                .iter_mut()
+                .for_each(|(_, fix)| *fix = remap(*fix));
+
+            let parts = parts
+                .entry((airway.ident.clone(), airway.area.clone()))
+                .or_default();
+            let mut joined: Vec<usize> = parts
+                .iter()
+                .copied()
+                .filter(|&part| airways[part].gap(&airway) == 0)
+                .collect();
+            if joined.is_empty() {
+                joined.extend(
+                    parts
+                        .iter()
+                        .copied()
+                        .min_by_key(|&part| airways[part].gap(&airway)),
+                );
+            }
+
+            let Some((&into, others)) = joined.split_first() else {
+                parts.push(airways.len());
+                airways.push(airway);
+                continue;
+            };
+
+            // the parts are disjoint, thus, they are joined without conflicts
+            for &part in others {
+                let fixes = std::mem::take(&mut airways[part].fixes);
+                airways[into].fixes.extend(fixes);
+            }
+            airways[into].fixes.sort_by_key(|&(seq, _)| seq);
+            parts.retain(|part| !others.contains(part));
+
+            let ident = airway.ident.clone();
+            if airways[into].merge(airway) {
+                conflicts.push(ident);
+            }
+        }
+
+        // joined parts are left without fixes
+        airways.retain(|airway| !airway.fixes.is_empty());
+        *self = Self::new(airways, fix_count);
+        conflicts
+    }
+
+    /// Maps the fixes by `remap` into a network of `fix_count` fixes.
+    ///
+    /// Fixes that are mapped to `None`, e.g. removed waypoints, split their
+    /// airway into parts with the same ident and area, so the fixes before
+    /// and after a removed fix aren't joined by a segment that doesn't exist.
+    /// Airways without any fix are dropped.
+    pub(crate) fn compact(&mut self, remap: impl Fn(u32) -> Option<u32>, fix_count: usize) {
+        let mut airways = Vec::new();
+
+        for airway in 0..self.len() {
+            let airway = self.airway(airway);
+            let mut part = Vec::new();
+
+            for (seq, fix) in airway.fixes.iter().copied() {
+                match remap(fix) {
+                    Some(fix) => part.push((seq, fix)),
+                    None if !part.is_empty() => airways.push(Airway {
+                        fixes: std::mem::take(&mut part),
+                        ..airway.clone()
+                    }),
+                    None => {}
+                }
+            }
+
+            if !part.is_empty() {
+                airways.push(Airway {
+                    fixes: part,
+                    ..airway
+                });
+            }
+        }
+
+        *self = Self::new(airways, fix_count);
+    }
+
+    fn airway(&self, airway: usize) -> Airway {
+        let range = self.offsets[airway] as usize..self.offsets[airway + 1] as usize;
+        Airway {
+            ident: self.idents[airway].clone(),
+            area: self.areas[airway].clone(),
+            cycle: self.cycles[airway],
+            fixes: self.seqs[range.clone()]
+                .iter()
+                .copied()
+                .zip(self.fixes[range].iter().copied())
+                .collect(),
+        }
+    }
+
+    fn airway_fixes(&self, airway: usize) -> &[u32] {
+        &self.fixes[self.offsets[airway] as usize..self.offsets[airway + 1] as usize]
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Returns the airway of the cycle 2501 with the `fixes` numbered in
+    /// steps of ten.
+    fn airway(ident: &str, fixes: Vec<u32>) -> Airway {
+        Airway {
+            ident: String::from(ident),
+            area: String::from("EUR"),
+            cycle: Some(AiracCycle::new(25, 1)),
+            fixes: (10..).step_by(10).zip(fixes).collect(),
+        }
+    }
+
+    fn network() -> Airways {
+        // 0 - 1 - 2 - 3 on A1 and 4 - 2 - 5 on B2
+        Airways::new(
+            vec![airway("A1", vec![0, 1, 2, 3]), airway("B2", vec![4, 2, 5])],
+            6,
+        )
+    }
+
+    #[test]
+    fn finds_positions_by_fix() {
+        let airways = network();
+        let a1 = airways.find("A1").next().expect("A1 should exist");
+        let b2 = airways.find("B2").next().expect("B2 should exist");
+
+        assert_eq!(
+            airways.positions(2),
+            &[
+                AirwayPosition {
+                    airway: a1 as u32,
+                    seq: 2
+                },
+                AirwayPosition {
+                    airway: b2 as u32,
+                    seq: 1
+                }
+            ]
+        );
+        assert!(airways.positions(6).is_empty());
+    }
+
+    #[test]
+    fn finds_airways_of_all_areas() {
+        let mut airways = network();
+        let other = Airways::new(
+            vec![Airway {
+                area: String::from("PAC"),
+                ..airway("A1", vec![5, 6])
+            }],
+            7,
+        );
+        assert!(airways.merge(other, |fix| fix, 7).is_empty());
+
+        let areas: Vec<&str> = airways.find("A1").map(|a1| airways.area(a1)).collect();
+        assert_eq!(areas, vec!["EUR", "PAC"]);
+        assert_eq!(airways.positions(6).len(), 1);
+    }
+
+    #[test]
+    fn neighbours_are_connected_by_airways() {
+        let airways = network();
+        let mut neighbours: Vec<usize> = airways.neighbours(2).map(|(fix, _)| fix).collect();
+        neighbours.sort();
+        assert_eq!(neighbours, vec![1, 3, 4, 5]);
+    }
+
+    #[test]
+    fn segment_in_both_directions() {
+        let airways = network();
+        let a1 = airways.find("A1").next().expect("A1 should exist");
+        assert_eq!(airways.segment(a1, 0, 3), vec![1, 2, 3]);
+        assert_eq!(airways.segment(a1, 3, 1), vec![2, 1]);
+    }
+
+    #[test]
+    fn merge_skips_equal_airways() {
+        let mut airways = network();
+        let other = Airways::new(
+            vec![airway("A1", vec![0, 1, 2, 3]), airway("C3", vec![3, 6])],
+            7,
+        );
+
+        assert!(airways.merge(other, |fix| fix, 7).is_empty());
+        assert_eq!(airways.len(), 3);
+        assert_eq!(airways.positions(6).len(), 1);
+
+        let other = Airways::new(vec![airway("A1", vec![0, 1, 3])], 7);
+        assert_eq!(airways.merge(other, |fix| fix, 7), vec![String::from("A1")]);
+    }
+
+    #[test]
+    fn merges_overlapping_parts_of_an_airway() {
+        // A1 is stated as 0 - 1 - 2 by one data and as 2 - 3 - 6 by the other
+        let mut airways = Airways::new(vec![airway("A1", vec![0, 1, 2])], 7);
+        let other = Airways::new(
+            vec![Airway {
+                fixes: vec![(30, 2), (40, 3), (50, 6)],
+                ..airway("A1", Vec::new())
+            }],
+            7,
+        );
+
+        assert!(airways.merge(other, |fix| fix, 7).is_empty());
+        assert_eq!(airways.len(), 1);
+
+        let a1 = airways.find("A1").next().expect("A1 should exist");
+        assert_eq!(airways.fixes(a1).collect::<Vec<_>>(), vec![0, 1, 2, 3, 6]);
+        assert_eq!(airways.find("A1").count(), 1);
+        assert_eq!(airways.positions(6).len(), 1);
+    }
+
+    #[test]
+    fn merge_prefers_airways_of_newer_cycle() {
+        let mut airways = network();
+        let newer = Airways::new(
+            vec![Airway {
+                cycle: Some(AiracCycle::new(25, 2)),
+                ..airway("A1", vec![0, 1, 5])
+            }],
+            7,
+        );
+        assert!(airways.merge(newer, |fix| fix, 7).is_empty());
+
+        let a1 = airways.find("A1").next().expect("A1 should exist");
+        assert_eq!(airways.fixes(a1).collect::<Vec<_>>(), vec![0, 1, 5, 3]);
+
+        // the airway is of the newer cycle now
+        let older = Airways::new(vec![airway("A1", vec![0, 4])], 7);
+        assert!(airways.merge(older, |fix| fix, 7).is_empty());
+        assert_eq!(airways.fixes(a1).collect::<Vec<_>>(), vec![0, 1, 5, 3]);
+    }
+
+    #[test]
+    fn compact_splits_airways_at_removed_fixes() {
+        let mut airways = network();
+        // fix 2 is removed and the following fixes move up
+        airways.compact(|fix| (fix != 2).then(|| fix - (fix > 2) as u32), 5);
+
+        let fixes = |ident| -> Vec<Vec<usize>> {
+            airways
+                .find(ident)
+                .map(|airway| airways.fixes(airway).collect())
+                .collect()
+        };
+        assert_eq!(fixes("A1"), vec![vec![0, 1], vec![2]]);
+        assert_eq!(fixes("B2"), vec![vec![3], vec![4]]);
+
+        // the fixes next to the removed one aren't connected anymore
+        assert_eq!(
+            airways
+                .neighbours(1)
+                .map(|(fix, _)| fix)
+                .collect::<Vec<_>>(),
+            vec![0]
+        );
+        assert_eq!(airways.neighbours(3).count(), 0);
+    }
+
+    #[test]
+    fn merge_joins_split_airways() {
+        let mut airways = network();
+        airways.compact(|fix| (fix != 2).then_some(fix), 6);
+        assert_eq!(airways.find("A1").count(), 2);
+
+        // reloading the removed fix bridges the gap
+        let other = Airways::new(vec![airway("A1", vec![0, 1, 2, 3])], 6);
+        assert!(airways.merge(other, |fix| fix, 6).is_empty());
+
+        let a1: Vec<usize> = airways.find("A1").collect();
+        assert_eq!(a1.len(), 1);
+        assert_eq!(airways.fixes(a1[0]).collect::<Vec<_>>(), vec![0, 1, 2, 3]);
+    }
+}
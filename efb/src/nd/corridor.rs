@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::collections::HashMap;
+
+use super::search::Entry;
+use super::{Airspace, NavAid, NavigationData};
+use crate::geom::Corridor;
+use crate::measurements::Length;
+use crate::nd::Fix;
+use crate::route::Route;
+
+/// The navigation data within a corridor along a route.
+///
+/// Each feature is returned with its along-track distance from the route's
+/// start to the position at which it's closest to the route, and the
+/// features are ordered by that distance.
+#[derive(Clone, PartialEq, Debug, Default)]
+pub struct CorridorFeatures<'a> {
+    /// The airports and waypoints within the corridor.
+    pub navaids: Vec<(Length, NavAid)>,
+    /// The airspaces that are within or reach into the corridor.
+    pub airspaces: Vec<(Length, &'a Airspace)>,
+}
+
+impl NavigationData {
+    /// Returns the airports, waypoints and airspaces within the `width` to
+    /// either side of the `route`, e.g. to prepare a briefing.
+    ///
+    /// A feature that is close to more than one leg is placed at the leg
+    /// it's closest to.
+    pub fn within_corridor(&self, route: &Route, width: Length) -> CorridorFeatures<'_> {
+        // the closest distance to the route and its along-track distance
+        let mut navaids: HashMap<Entry, (f32, f32)> = HashMap::new();
+        let mut airspaces: HashMap<usize, (f32, f32)> = HashMap::new();
+        let closest = |(along, dist): (f32, f32), best: &mut (f32, f32)| {
+            if dist < best.1 {
+                *best = (along, dist);
+            }
+        };
+
+        let mut offset = 0.0;
+        for leg in route.legs() {
+            let (from, to) = (leg.from().coordinate(), leg.to().coordinate());
+
+            for part in Corridor::along(&from, &to, width) {
+                let bbox = part.bbox();
+                for entry in self.spatial_index().within(&bbox) {
+                    let coord = self.coordinate(entry);
+                    let (along, dist) = part.locate(coord.latitude, coord.longitude);
+                    if dist <= part.radius {
+                        let best = navaids.entry(entry).or_insert((0.0, f32::INFINITY));
+                        closest((offset + along, dist), best);
+                    }
+                }
+
+                for i in self.airspace_geometry().within(&bbox) {
+                    let approach = self.airspace_geometry().approach(i, &part);
+                    if let Some((along, dist)) = approach.filter(|(_, dist)| *dist <= part.radius) {
+                        let best = airspaces.entry(i).or_insert((0.0, f32::INFINITY));
+                        closest((offset + along, dist), best);
+                    }
+                }
+
+                offset += part.len();
+            }
+        }
+
+        let mut features = CorridorFeatures {
+            navaids: navaids
+                .into_iter()
+                .map(|(entry, (along, _))| (Length::nm(along), self.navaid(entry)))
+                .collect(),
+            airspaces: airspaces
+                .into_iter()
+                .map(|(i, (along, _))| (Length::nm(along), &*self.airspaces[i]))
+                .collect(),
+        };
+
+        features
+            .navaids
+            .sort_by(|a, b| a.0.value().total_cmp(b.0.value()));
+        features
+            .airspaces
+            .sort_by(|a, b| a.0.value().total_cmp(b.0.value()));
+        features
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const ARINC_424_RECORDS: &str = r#"SEURP EDDHEDA        0        N N53374900E009591762E002000053                   P    MWGE    HAMBURG                       356462409
+SEURPCEDDHED N1    ED0    V     N53482105E010015451                                 WGE           NOVEMBER1                359892409
+SEURPCEDDHED N2    ED0    V     N53405701E010000576                                 WGE           NOVEMBER2                359902409
+SEURP EDHFEDA        0        N N53593300E009343600E000000082                   P    MWGE    ITZEHOE/HUNGRIGER WOLF        320782409
+SEURP EDDFEDA        0        N N50020000E008340000E000000364                   P    MWGE    FRANKFURT MAIN                356472409
+"#;
+
+    const OPENAIR_RECORDS: &str = r#"AC D
+AN CROSSED
+AH FL 65
+AL GND
+DP 53:50:00 N 9:40:00 E
+DP 53:50:00 N 9:50:00 E
+DP 53:40:00 N 9:50:00 E
+DP 53:40:00 N 9:40:00 E
+DP 53:50:00 N 9:40:00 E
+AC D
+AN FAR
+AH FL 65
+AL GND
+DP 52:10:00 N 9:40:00 E
+DP 52:10:00 N 9:50:00 E
+DP 52:00:00 N 9:50:00 E
+DP 52:00:00 N 9:40:00 E
+DP 52:10:00 N 9:40:00 E
+"#;
+
+    #[test]
+    fn features_along_route() {
+        let mut nd =
+            NavigationData::try_from_arinc424(ARINC_424_RECORDS).expect("records should be valid");
+        nd.append(
+            NavigationData::try_from_openair(OPENAIR_RECORDS).expect("airspaces should be valid"),
+        );
+
+        let mut route = Route::new();
+        route
+            .decode("EDDH DHN2 EDHF", &nd)
+            .expect("route should decode");
+
+        let features = nd.within_corridor(&route, Length::nm(3.0));
+        let navaids: Vec<(f32, String)> = features
+            .navaids
+            .iter()
+            .map(|(along, navaid)| (along.value().round(), navaid.ident()))
+            .collect();
+        let airspaces: Vec<(f32, &str)> = features
+            .airspaces
+            .iter()
+            .map(|(along, airspace)| (along.value().round(), airspace.name.as_str()))
+            .collect();
+
+        // N1 is off the route and EDDF and FAR far away
+        assert_eq!(
+            navaids,
+            vec![
+                (0.0, String::from("EDDH")),
+                (3.0, String::from("DHN2")),
+                (27.0, String::from("EDHF"))
+            ]
+        );
+        assert_eq!(airspaces, vec![(13.0, "CROSSED")]);
+    }
+}
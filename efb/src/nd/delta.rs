@@ -0,0 +1,559 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::collections::HashMap;
+use std::str::FromStr;
+
+use crate::error::Error;
+use crate::VerticalDistance;
+
+use super::partition::Partition;
+use super::records::{Materialize, Records};
+use super::search::{Entry, SearchIndex};
+use super::{
+    AiracCycle, Airport, Fix, LocationIndicator, NavigationData, Runway, RunwaySurface, Waypoint,
+};
+
+/// The length of an ARINC 424 record.
+const RECORD_LEN: usize = 132;
+
+type AirportKey = <Airport as Materialize>::Key;
+type WaypointKey = <Waypoint as Materialize>::Key;
+
+/// The change of a record within a [`Delta`].
+#[derive(Copy, Clone, Eq, PartialEq, Debug)]
+enum Change {
+    Added,
+    Modified,
+    Removed,
+}
+
+#[derive(Clone, Debug)]
+enum Record {
+    // airports and waypoints are built when applied, so their declination is
+    // evaluated at the epoch of the updated data
+    Airport(String),
+    Runway(AirportKey, Runway),
+    Waypoint(String),
+}
+
+/// The changes of navigation data from one AIRAC cycle to the next.
+///
+/// A delta consists of ARINC 424 records, each prefixed by its change:
+///
+/// - `+` an added record
+/// - `~` a modified record that replaces the record with the same key
+/// - `-` a removed record
+///
+/// Records are keyed by their section and the ident, region and location of
+/// the airport or waypoint. Runways are keyed by their airport and
+/// designator and modify their airport. A line `#` followed by a
+/// hexadecimal [content hash] of the updated data allows to verify the
+/// update. The data is of the newest cycle of the records once updated.
+///
+/// [content hash]: NavigationData::content_hash
+///
+/// # Examples
+///
+/// ```
+/// # use efb::nd::{Delta, NavigationData};
+/// let mut nd = NavigationData::try_from_arinc424(
+///     "SEURP EDDHEDA        0        N N53374900E009591762E002000053                   P    MWGE    HAMBURG                       356462409",
+/// )
+/// .unwrap();
+///
+/// let delta: Delta =
+///     "+SEURP EDHFEDA        0        N N53593300E009343600E000000082                   P    MWGE    ITZEHOE/HUNGRIGER WOLF        320782410"
+///         .parse()
+///         .unwrap();
+///
+/// nd.apply_delta(&delta).unwrap();
+/// assert!(nd.find("EDHF").is_some());
+/// ```
+#[derive(Clone, Debug, Default)]
+pub struct Delta {
+    records: Vec<(Change, Record)>,
+    hash: Option<u64>,
+    cycle: Option<AiracCycle>,
+}
+
+impl Delta {
+    /// Returns the number of changed records.
+    pub fn len(&self) -> usize {
+        self.records.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.records.is_empty()
+    }
+
+    /// Returns the content hash of the updated navigation data.
+    pub fn hash(&self) -> Option<u64> {
+        self.hash
+    }
+
+    /// Returns the newest cycle of the added and modified airports and
+    /// waypoints.
+    pub fn cycle(&self) -> Option<&AiracCycle> {
+        self.cycle.as_ref()
+    }
+}
+
+impl FromStr for Delta {
+    type Err = Error;
+
+    fn from_str(s: &str) -> Result<Self, Self::Err> {
+        let mut delta = Delta::default();
+
+        for line in s.lines().filter(|line| !line.trim().is_empty()) {
+            let err = || Error::UnexpectedDeltaRecord(line.to_string());
+            let (change, record) = line.split_at_checked(1).ok_or_else(err)?;
+
+            let change = match change {
+                "+" => Change::Added,
+                "~" => Change::Modified,
+                "-" => Change::Removed,
+                "#" => {
+                    delta.hash = Some(u64::from_str_radix(record.trim(), 16).map_err(|_| err())?);
+                    continue;
+                }
+                _ => return Err(err()),
+            };
+
+            // fields are read by column, thus, short records are rejected
+            if record.len() < RECORD_LEN || !record.is_ascii() {
+                return Err(err());
+            }
+
+            let (record, cycle) = match (&record[4..6], &record[12..13]) {
+                ("EA" | "PC", _) => arinc424::Waypoint::from_str(record)
+                    .map(|wp| (Record::Waypoint(record.to_string()), Some(wp.cycle.into()))),
+                ("P ", "A") => arinc424::Airport::from_str(record)
+                    .map(|aprt| (Record::Airport(record.to_string()), Some(aprt.cycle.into()))),
+                ("P ", "G") => arinc424::Runway::from_str(record).map(|rwy| {
+                    let airport = (
+                        rwy.arpt_ident.to_string(),
+                        LocationIndicator::new(rwy.icao_code.as_str()).ok(),
+                    );
+                    // like when loading, the cycle of the data is of its
+                    // airports and waypoints only
+                    (Record::Runway(airport, Runway::from(rwy)), None)
+                }),
+                // airways and procedures can't be updated by a delta
+                _ => return Err(err()),
+            }
+            .map_err(|_| err())?;
+
+            if change != Change::Removed {
+                delta.cycle = delta.cycle.max(cycle);
+            }
+            delta.records.push((change, record));
+        }
+
+        Ok(delta)
+    }
+}
+
+/// The updated items of records with their content hash, each with the
+/// index of the item it replaces.
+struct Updates<T: Materialize> {
+    items: Vec<(Option<usize>, Option<(T, u64)>)>,
+    slots: HashMap<T::Key, usize>,
+}
+
+impl<T: Materialize + Clone> Updates<T> {
+    fn new() -> Self {
+        Self {
+            items: Vec::new(),
+            slots: HashMap::new(),
+        }
+    }
+
+    /// Creates updates that remove the items at the `indices`.
+    fn removals(indices: &[u32]) -> Self {
+        Self {
+            items: indices.iter().map(|&i| (Some(i as usize), None)).collect(),
+            slots: HashMap::new(),
+        }
+    }
+
+    /// Returns the updated item with the `key` and its hash, which is
+    /// initially the item of the `records` if any.
+    fn slot(
+        &mut self,
+        key: T::Key,
+        records: &Records<T>,
+    ) -> &mut (Option<usize>, Option<(T, u64)>) {
+        let slot = *self.slots.entry(key).or_insert_with_key(|key| {
+            let index = records.index_of(key);
+            let item = index.and_then(|i| Some((T::clone(records.get(i)?), records.hash_at(i))));
+            self.items.push((index, item));
+            self.items.len() - 1
+        });
+
+        &mut self.items[slot]
+    }
+
+    /// Returns the change of the content hash of the `records` if the
+    /// updates are applied.
+    fn hash(&self, records: &Records<T>) -> u64 {
+        self.items.iter().fold(0, |hash, (index, item)| {
+            let old = index.map_or(0, |i| records.hash_at(i));
+            let new = item.as_ref().map_or(0, |(_, hash)| *hash);
+            hash.wrapping_sub(old).wrapping_add(new)
+        })
+    }
+
+    /// Applies the updates to the `records` together with the `partition`
+    /// and the search `index` if they're built.
+    fn apply(
+        self,
+        records: &mut Records<T>,
+        mut partition: Option<&mut Partition>,
+        mut index: Option<&mut SearchIndex>,
+        entry: fn(u32) -> Entry,
+    ) {
+        for (i, item) in self.items {
+            if let Some(i) = i {
+                if let Some(key) = records.key_at(i) {
+                    if let Some(partition) = partition.as_deref_mut() {
+                        partition.remove(T::location(&key), i as u32);
+                    }
+                }
+                if let Some(index) = index.as_deref_mut() {
+                    index.remove(records.ident(i), &records.name(i), entry(i as u32));
+                }
+            }
+
+            let i = match (i, item) {
+                (Some(i), Some((item, hash))) => {
+                    records.replace(i, item, hash);
+                    i
+                }
+                (Some(i), None) => {
+                    records.remove(i);
+                    continue;
+                }
+                (None, Some((item, hash))) => {
+                    records.push(item, hash);
+                    records.len() - 1
+                }
+                (None, None) => continue,
+            };
+
+            let key = records.key_at(i).expect("item should be updated");
+            if let Some(partition) = partition.as_deref_mut() {
+                partition.insert(T::location(&key), i as u32);
+            }
+            if let Some(index) = index.as_deref_mut() {
+                index.insert(records.ident(i), &records.name(i), entry(i as u32));
+            }
+        }
+    }
+}
+
+/// Applies the `delta` to the `nd`.
+///
+/// All changes are prepared before anything is updated, thus, the data stays
+/// untouched if the delta is invalid or doesn't match the hash. Only the
+/// changed records are built, since the content hash is kept per record.
+pub(crate) fn apply(nd: &mut NavigationData, delta: &Delta) -> Result<(), Error> {
+    let hash = nd.content_hash();
+
+    let mut airports: Updates<Airport> = Updates::new();
+    let mut waypoints: Updates<Waypoint> = Updates::new();
+    let grid = nd.declination_grid();
+
+    for (change, record) in &delta.records {
+        match record {
+            Record::Airport(line) => {
+                let aprt = Airport::materialize(line, std::iter::empty(), &grid);
+                let (_, item) = airports.slot(aprt.key(), &nd.airports);
+                *item = match (change, item.take()) {
+                    (Change::Removed, None) | (Change::Modified, None) => {
+                        return Err(Error::UnknownIdent(aprt.ident()));
+                    }
+                    (Change::Removed, Some(_)) => None,
+                    // runways are records of their own and kept
+                    (_, existing) => {
+                        let runways = existing
+                            .map(|(existing, _)| existing.runways)
+                            .unwrap_or_default();
+                        let hash = runways
+                            .iter()
+                            .fold(Airport::raw_hash(line, std::iter::empty()), |hash, rwy| {
+                                hash.wrapping_add(runway_hash(rwy))
+                            });
+                        Some((Airport { runways, ..aprt }, hash))
+                    }
+                };
+            }
+            Record::Runway(key, rwy) => {
+                let (_, item) = airports.slot(key.clone(), &nd.airports);
+                let (aprt, hash) = item
+                    .as_mut()
+                    .ok_or_else(|| Error::UnknownIdent(key.0.clone()))?;
+                let existing = aprt
+                    .runways
+                    .iter()
+                    .position(|existing| existing.designator == rwy.designator);
+
+                match (change, existing) {
+                    (Change::Removed, Some(i)) => {
+                        *hash = hash.wrapping_sub(runway_hash(&aprt.runways.remove(i)));
+                    }
+                    (Change::Added, Some(i)) | (Change::Modified, Some(i)) => {
+                        *hash = hash
+                            .wrapping_sub(runway_hash(&aprt.runways[i]))
+                            .wrapping_add(runway_hash(rwy));
+                        aprt.runways[i] = rwy.clone();
+                    }
+                    (Change::Added, None) => {
+                        *hash = hash.wrapping_add(runway_hash(rwy));
+                        aprt.runways.push(rwy.clone());
+                    }
+                    (_, None) => {
+                        return Err(Error::UnknownIdent(format!(
+                            "{}{}",
+                            aprt.icao_ident, rwy.designator
+                        )));
+                    }
+                }
+            }
+            Record::Waypoint(line) => {
+                let wp = Waypoint::materialize(line, std::iter::empty(), &grid);
+                let (_, item) = waypoints.slot(wp.key(), &nd.waypoints);
+                *item = match (change, item.is_some()) {
+                    (Change::Removed, false) | (Change::Modified, false) => {
+                        return Err(Error::UnknownIdent(wp.ident()));
+                    }
+                    (Change::Removed, true) => None,
+                    _ => Some((wp, Waypoint::raw_hash(line, std::iter::empty()))),
+                };
+            }
+        }
+    }
+
+    let hash = hash
+        .wrapping_add(airports.hash(&nd.airports))
+        .wrapping_add(waypoints.hash(&nd.waypoints));
+
+    if let Some(expected) = delta.hash.filter(|&expected| expected != hash) {
+        return Err(Error::DeltaHashMismatch {
+            expected,
+            actual: hash,
+        });
+    }
+
+    for location in airports
+        .items
+        .iter()
+        .filter_map(|(_, item)| item.as_ref()?.0.location)
+        .chain(
+            waypoints
+                .items
+                .iter()
+                .filter_map(|(_, item)| item.as_ref()?.0.location),
+        )
+    {
+        if !nd.locations.contains(&location) {
+            nd.locations.push(location);
+        }
+    }
+
+    update(nd, airports, waypoints);
+    nd.cycle = nd.cycle.max(delta.cycle);
+
+    Ok(())
+}
+
+/// Removes the airports and waypoints at the indices from the `nd`.
+pub(crate) fn remove(nd: &mut NavigationData, airports: &[u32], waypoints: &[u32]) {
+    update(
+        nd,
+        Updates::removals(airports),
+        Updates::removals(waypoints),
+    );
+}
+
+/// Applies the updates to the records and the values derived from them.
+fn update(nd: &mut NavigationData, airports: Updates<Airport>, waypoints: Updates<Waypoint>) {
+    // moved records would change cells, thus the index is rebuilt when needed
+    nd.spatial.reset();
+
+    let (airport_partition, waypoint_partition) = match nd.partitions.get_mut() {
+        Some(partitions) => (
+            Some(&mut partitions.airports),
+            Some(&mut partitions.waypoints),
+        ),
+        None => (None, None),
+    };
+    let mut index = nd.index.get_mut();
+
+    airports.apply(
+        &mut nd.airports,
+        airport_partition,
+        index.as_deref_mut(),
+        Entry::Airport,
+    );
+    waypoints.apply(
+        &mut nd.waypoints,
+        waypoint_partition,
+        index,
+        Entry::Waypoint,
+    );
+}
+
+/// Returns the content hash of a raw record `line`.
+///
+/// The hash is independent of the platform and release, unlike the hasher
+/// of the standard library, and of the epoch at which the declination of
+/// the record is evaluated.
+pub(crate) fn record_hash(line: &str) -> u64 {
+    Fnv1a::new().write(line.as_bytes()).finish()
+}
+
+/// Returns the content hash of a runway, which adds to the hash of its
+/// airport's record.
+///
+/// Runways are hashed by their fields rather than by their line, since a
+/// delta modifies runways of airports whose lines aren't kept.
+pub(crate) fn runway_hash(rwy: &Runway) -> u64 {
+    let surface: &[u8] = match rwy.surface {
+        RunwaySurface::Asphalt => b"A",
+        RunwaySurface::Concrete => b"C",
+        RunwaySurface::Grass => b"G",
+    };
+
+    Fnv1a::new()
+        .str(&rwy.designator)
+        .f32(rwy.bearing.to_si())
+        .f32(rwy.length.to_si())
+        .f32(rwy.tora.to_si())
+        .f32(rwy.toda.to_si())
+        .f32(rwy.lda.to_si())
+        .write(surface)
+        .f32(rwy.slope)
+        .vertical_distance(rwy.elev)
+        .finish()
+}
+
+/// The 64-bit FNV-1a hash.
+struct Fnv1a(u64);
+
+impl Fnv1a {
+    fn new() -> Self {
+        Self(0xcbf29ce484222325)
+    }
+
+    fn write(mut self, bytes: &[u8]) -> Self {
+        for byte in bytes {
+            self.0 = (self.0 ^ *byte as u64).wrapping_mul(0x100000001b3);
+        }
+        self
+    }
+
+    fn str(self, s: &str) -> Self {
+        // terminated so adjacent strings can't be shifted into each other
+        self.write(s.as_bytes()).write(&[0xff])
+    }
+
+    fn f32(self, value: f32) -> Self {
+        self.write(&value.to_bits().to_le_bytes())
+    }
+
+    fn vertical_distance(self, vd: VerticalDistance) -> Self {
+        // tagged so equal values of different references differ
+        match vd {
+            VerticalDistance::Agl(value) => self.write(b"A").write(&value.to_le_bytes()),
+            VerticalDistance::Altitude(value) => self.write(b"L").write(&value.to_le_bytes()),
+            VerticalDistance::PressureAltitude(value) => {
+                self.write(b"P").write(&value.to_le_bytes())
+            }
+            VerticalDistance::Fl(value) => self.write(b"F").write(&value.to_le_bytes()),
+            VerticalDistance::Gnd => self.write(b"G"),
+            VerticalDistance::Msl(value) => self.write(b"M").write(&value.to_le_bytes()),
+            VerticalDistance::Unlimited => self.write(b"U"),
+        }
+    }
+
+    fn finish(self) -> u64 {
+        self.0
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use crate::DeclinationGrid;
+
+    use super::*;
+
+    #[test]
+    fn fnv1a_of_known_input() {
+        assert_eq!(Fnv1a::new().finish(), 0xcbf29ce484222325);
+        assert_eq!(Fnv1a::new().write(b"a").finish(), 0xaf63dc4c8601ec8c);
+    }
+
+    #[test]
+    fn parses_delta() {
+        let delta: Delta = "~SEURP EDDHEDGRW33    0120273330 N53374300E009595081                          151                                           124362502\n-SEURPCEDDHED N1    ED0    V     N53482105E010015451                                 WGE           NOVEMBER1                359892409\n#00ff"
+            .parse()
+            .expect("delta should be valid");
+
+        assert_eq!(delta.len(), 2);
+        assert_eq!(delta.hash(), Some(0xff));
+        assert!(matches!(
+            delta.records[0],
+            (Change::Modified, Record::Runway(_, _))
+        ));
+    }
+
+    #[test]
+    fn rejects_unexpected_records() {
+        assert!("*SEURP EDDHEDA".parse::<Delta>().is_err());
+        assert!("+SEURP EDDHEDA".parse::<Delta>().is_err());
+        assert!("# not a hash".parse::<Delta>().is_err());
+    }
+
+    #[test]
+    fn hashes_raw_records() {
+        let eddh = "SEURP EDDHEDA        0        N N53374900E009591762E002000053                   P    MWGE    HAMBURG                       356462409";
+        let rwy15 = "SEURP EDDHEDGRW15    0120271510 N53391236E009583910                          151                                           124362502";
+        let rwy33 = "SEURP EDDHEDGRW33    0120273330 N53374300E009595081                          151                                           124362502";
+
+        // runways are hashed in any order
+        let hash = Airport::raw_hash(eddh, [rwy15, rwy33].into_iter());
+        assert_eq!(hash, Airport::raw_hash(eddh, [rwy33, rwy15].into_iter()));
+
+        let grid = DeclinationGrid::new(time::Date::MIN);
+        let aprt = Airport::materialize(eddh, [rwy15, rwy33].into_iter(), &grid);
+        assert_eq!(
+            aprt.runways.iter().fold(record_hash(eddh), |hash, rwy| hash
+                .wrapping_add(runway_hash(rwy))),
+            hash
+        );
+
+        for other in [
+            Airport::raw_hash(&eddh.replace("E0020", "W0020"), [rwy15, rwy33].into_iter()),
+            Airport::raw_hash(eddh, [rwy15].into_iter()),
+            Airport::raw_hash(
+                eddh,
+                [rwy15, &rwy33.replace("0120273330", "0130273330")].into_iter(),
+            ),
+        ] {
+            assert_ne!(hash, other);
+        }
+    }
+}
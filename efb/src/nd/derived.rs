@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::cell::OnceCell;
+
+/// A value that is derived from the navigation data on first use, e.g. an
+/// index.
+///
+/// Derived values are ignored when comparing navigation data, since they
+/// follow from the data itself.
+#[derive(Clone, Debug)]
+pub(crate) struct Derived<T>(OnceCell<T>);
+
+impl<T> Derived<T> {
+    pub(crate) fn get_or_init(&self, f: impl FnOnce() -> T) -> &T {
+        self.0.get_or_init(f)
+    }
+
+    /// Returns the value if it was derived already.
+    pub(crate) fn get(&self) -> Option<&T> {
+        self.0.get()
+    }
+
+    /// Returns the value if it was derived already.
+    pub(crate) fn get_mut(&mut self) -> Option<&mut T> {
+        self.0.get_mut()
+    }
+
+    /// Sets the value, e.g. after it was updated outside of the cell.
+    pub(crate) fn set(&mut self, value: T) {
+        self.0 = OnceCell::from(value);
+    }
+
+    /// Drops the value so it's derived again on next use.
+    pub(crate) fn reset(&mut self) {
+        self.0.take();
+    }
+}
+
+impl<T> Default for Derived<T> {
+    fn default() -> Self {
+        Self(OnceCell::new())
+    }
+}
+
+impl<T> PartialEq for Derived<T> {
+    fn eq(&self, _other: &Self) -> bool {
+        true
+    }
+}
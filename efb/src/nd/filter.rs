@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use crate::geom::{BBox, Coordinate, Polygon};
+
+use super::{Airspace, AirspaceClass, LocationIndicator};
+
+/// Filter applied while navigation data is loaded.
+///
+/// Only records that pass all criteria of the filter are loaded. Records are
+/// checked before they are converted into airports, waypoints or airspaces,
+/// thus, skipped records cost neither conversion nor memory. A filter without
+/// any criteria passes all records.
+///
+/// # Examples
+///
+/// ```
+/// # use efb::geom::{BBox, Coordinate};
+/// # use efb::nd::{Filter, LocationIndicator};
+/// # use efb::coord;
+/// // load only German navigation aids north of 52°N
+/// let filter = Filter::new()
+///     .locations([LocationIndicator::new("ED").unwrap()])
+///     .bbox(BBox::new(&[coord!(52.0, 6.0), coord!(55.0, 15.0)]).unwrap());
+/// ```
+#[derive(Clone, PartialEq, Debug, Default)]
+pub struct Filter {
+    bbox: Option<BBox>,
+    corridor: Option<(Polygon, BBox)>,
+    locations: Vec<LocationIndicator>,
+    classes: Vec<AirspaceClass>,
+}
+
+impl Filter {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Passes only records within the bounding box.
+    pub fn bbox(mut self, bbox: BBox) -> Self {
+        self.bbox = Some(bbox);
+        self
+    }
+
+    /// Passes only records within the corridor, e.g. a polygon around a
+    /// route. Airspaces pass if they overlap the corridor.
+    pub fn corridor(mut self, corridor: Polygon) -> Self {
+        self.corridor = corridor.bbox().map(|bbox| (corridor, bbox));
+        self
+    }
+
+    /// Passes only navigation aids of the locations.
+    pub fn locations(mut self, locations: impl IntoIterator<Item = LocationIndicator>) -> Self {
+        self.locations = locations.into_iter().collect();
+        self
+    }
+
+    /// Passes only airspaces of the classes.
+    pub fn airspace_classes(mut self, classes: impl IntoIterator<Item = AirspaceClass>) -> Self {
+        self.classes = classes.into_iter().collect();
+        self
+    }
+
+    /// Returns `true` if a navigation aid at the `coordinate` and `location`
+    /// passes the filter.
+    pub(crate) fn includes(
+        &self,
+        coordinate: &Coordinate,
+        location: Option<LocationIndicator>,
+    ) -> bool {
+        (self.locations.is_empty() || location.is_some_and(|l| self.locations.contains(&l)))
+            && self
+                .bbox
+                .as_ref()
+                .is_none_or(|bbox| bbox.contains(coordinate))
+            && self.corridor.as_ref().is_none_or(|(corridor, bbox)| {
+                bbox.contains(coordinate) && corridor.contains(coordinate)
+            })
+    }
+
+    /// Returns `true` if the `airspace` passes the filter.
+    pub(crate) fn includes_airspace(&self, airspace: &Airspace) -> bool {
+        if !self.classes.is_empty() && !self.classes.contains(&airspace.class) {
+            return false;
+        }
+
+        if self.bbox.is_none() && self.corridor.is_none() {
+            return true;
+        }
+
+        // the bounds are compared first since most airspaces are far off
+        airspace.polygon.bbox().is_some_and(|extent| {
+            self.bbox
+                .as_ref()
+                .is_none_or(|bbox| bbox.intersects(&extent))
+                && self.corridor.as_ref().is_none_or(|(corridor, bbox)| {
+                    bbox.intersects(&extent) && corridor.intersects(&airspace.polygon)
+                })
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use crate::VerticalDistance;
+
+    use super::*;
+
+    #[test]
+    fn includes_navaids_within_filter() {
+        let ed = LocationIndicator::new("ED").expect("ED should be a valid location");
+        let eh = LocationIndicator::new("EH").expect("EH should be a valid location");
+        let filter = Filter::new().locations([ed]).corridor(polygon![
+            (53.0, 9.0),
+            (54.0, 9.0),
+            (54.0, 10.0),
+            (53.0, 10.0),
+            (53.0, 9.0)
+        ]);
+
+        assert!(filter.includes(&coord!(53.5, 9.5), Some(ed)));
+        assert!(!filter.includes(&coord!(53.5, 9.5), Some(eh)));
+        assert!(!filter.includes(&coord!(53.5, 9.5), None));
+        assert!(!filter.includes(&coord!(52.5, 9.5), Some(ed)));
+        assert!(Filter::new().includes(&coord!(52.5, 9.5), None));
+    }
+
+    #[test]
+    fn includes_airspaces_within_filter() {
+        let airspace = Airspace {
+            name: String::from("TMA BREMEN A"),
+            class: AirspaceClass::D,
+            ceiling: VerticalDistance::Fl(65),
+            floor: VerticalDistance::Msl(1500),
+            polygon: polygon![
+                (53.1, 8.9),
+                (53.1, 9.1),
+                (52.9, 9.1),
+                (52.9, 8.9),
+                (53.1, 8.9)
+            ],
+        };
+
+        let bbox = |sw, ne| BBox::new(&[sw, ne]).expect("bbox should be some");
+
+        assert!(Filter::new()
+            .bbox(bbox(coord!(53.0, 9.0), coord!(54.0, 10.0)))
+            .includes_airspace(&airspace));
+        assert!(!Filter::new()
+            .bbox(bbox(coord!(53.5, 9.0), coord!(54.0, 10.0)))
+            .includes_airspace(&airspace));
+        assert!(!Filter::new()
+            .airspace_classes([AirspaceClass::CTR])
+            .includes_airspace(&airspace));
+
+        // a diagonal corridor whose bounding box contains the airspace
+        let corridor = |points: [(f32, f32); 5]| {
+            Filter::new().corridor(points.map(|(lat, lon)| coord!(lat, lon)).to_vec().into())
+        };
+        assert!(!corridor([
+            (52.0, 8.0),
+            (52.0, 8.1),
+            (54.0, 11.1),
+            (54.0, 11.0),
+            (52.0, 8.0)
+        ])
+        .includes_airspace(&airspace));
+        assert!(corridor([
+            (52.0, 10.0),
+            (52.0, 10.1),
+            (54.0, 8.1),
+            (54.0, 8.0),
+            (52.0, 10.0)
+        ])
+        .includes_airspace(&airspace));
+    }
+}
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::cmp::Ordering;
+use std::fmt::{Display, Formatter, Result};
+
+use super::AiracCycle;
+
+/// A record that is within both merged navigation data with different content
+/// but of the same AIRAC cycle.
+///
+/// The record of the navigation data into which is merged is kept.
+#[derive(Clone, PartialEq, Debug)]
+pub enum MergeConflict {
+    Airport(String),
+    Waypoint(String),
+    Airway(String),
+    Procedure { airport: String, ident: String },
+}
+
+impl Display for MergeConflict {
+    fn fmt(&self, f: &mut Formatter<'_>) -> Result {
+        match self {
+            Self::Airport(ident) => write!(f, "airport {ident} differs"),
+            Self::Waypoint(ident) => write!(f, "waypoint {ident} differs"),
+            Self::Airway(ident) => write!(f, "airway {ident} differs"),
+            Self::Procedure { airport, ident } => {
+                write!(f, "procedure {ident} of {airport} differs")
+            }
+        }
+    }
+}
+
+/// How to resolve a record that differs between two navigation data.
+#[derive(Copy, Clone, Eq, PartialEq, Debug)]
+pub(crate) enum Resolution {
+    /// Keep our record since it's newer.
+    Keep,
+    /// Replace our record by their newer record.
+    Replace,
+    /// Keep our record but report a conflict since both are of the same cycle.
+    Conflict,
+}
+
+impl Resolution {
+    /// Resolves a difference by the cycle of `ours` and `theirs`.
+    pub(crate) fn new(ours: Option<AiracCycle>, theirs: Option<AiracCycle>) -> Self {
+        match theirs.cmp(&ours) {
+            Ordering::Greater => Self::Replace,
+            Ordering::Equal => Self::Conflict,
+            Ordering::Less => Self::Keep,
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn newer_cycle_wins() {
+        let older = Some(AiracCycle::new(25, 1));
+        let newer = Some(AiracCycle::new(25, 2));
+
+        assert_eq!(Resolution::new(older, newer), Resolution::Replace);
+        assert_eq!(Resolution::new(newer, older), Resolution::Keep);
+        assert_eq!(Resolution::new(newer, newer), Resolution::Conflict);
+    }
+}
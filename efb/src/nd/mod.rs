@@ -15,33 +15,68 @@
 
 //! Navigation Data.
 
+use std::collections::{BinaryHeap, HashMap};
 use std::rc::Rc;
 
+use chrono::{Datelike, NaiveDate};
+
 #[cfg(feature = "serde")]
 use serde::{Deserialize, Serialize};
 
 use crate::error::Error;
-use crate::geom::Coordinate;
-use crate::MagneticVariation;
+use crate::geom::{BBox, Coordinate, Corridor};
+use crate::measurements::{Angle, Length, LengthUnit, Speed};
+use crate::{DeclinationGrid, MagneticVariation, VerticalDistance};
 
 mod airac_cycle;
 mod airport;
 mod airspace;
+mod airway;
+mod corridor;
+mod delta;
+mod derived;
+mod filter;
 mod fix;
 mod location;
+mod merge;
 mod navaid;
+mod obstacle;
 mod parser;
+mod partition;
+mod procedure;
+mod records;
 mod runway;
+mod search;
+mod spatial;
+mod store;
+mod terrain;
 mod waypoint;
 
 pub use airac_cycle::{AiracCycle, CycleValidity};
 pub use airport::Airport;
-pub use airspace::{Airspace, AirspaceClass, Airspaces};
+use airspace::AirspaceGeometry;
+pub use airspace::{Airspace, AirspaceClass, AirspaceEntry, Airspaces};
+use airway::Airway;
+pub use airway::{AirwayPosition, Airways};
+pub use corridor::CorridorFeatures;
+pub use delta::Delta;
+use derived::Derived;
+pub use filter::Filter;
 pub use fix::Fix;
 pub use location::LocationIndicator;
+pub use merge::MergeConflict;
+use merge::Resolution;
 pub use navaid::NavAid;
+pub use obstacle::{Obstacle, ObstacleClearance, Obstacles};
 use parser::*;
+use partition::Partitions;
+pub use procedure::{Procedure, ProcedureKind, Procedures, Transition, TransitionKind};
+use records::Records;
 pub use runway::*;
+use search::{Entry, SearchIndex};
+use spatial::SpatialIndex;
+pub use store::CycleStore;
+pub use terrain::TerrainGrid;
 pub use waypoint::*;
 
 #[repr(C)]
@@ -54,11 +89,27 @@ pub enum InputFormat {
 #[derive(Clone, PartialEq, Debug, Default)]
 #[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
 pub struct NavigationData {
-    airports: Vec<Rc<Airport>>,
-    airspaces: Airspaces,
-    waypoints: Vec<Rc<Waypoint>>,
+    // airspaces, airways and procedures are shared with the navigation data
+    // of other cycles if unchanged
+    airports: Records<Airport>,
+    airspaces: Vec<Rc<Airspace>>,
+    waypoints: Records<Waypoint>,
+    airways: Rc<Airways>,
+    procedures: Rc<Procedures>,
     locations: Vec<LocationIndicator>,
     cycle: Option<AiracCycle>,
+    // the date at which the declination of records without a stated magnetic
+    // variation is evaluated
+    #[cfg_attr(feature = "serde", serde(skip))]
+    epoch: Option<NaiveDate>,
+    #[cfg_attr(feature = "serde", serde(skip))]
+    index: Derived<SearchIndex>,
+    #[cfg_attr(feature = "serde", serde(skip))]
+    geometry: Derived<AirspaceGeometry>,
+    #[cfg_attr(feature = "serde", serde(skip))]
+    partitions: Derived<Partitions>,
+    #[cfg_attr(feature = "serde", serde(skip))]
+    spatial: Derived<SpatialIndex>,
 }
 
 impl NavigationData {
@@ -68,27 +119,76 @@ impl NavigationData {
 
     /// Creates navigation data from an ARINC 424 string.
     pub fn try_from_arinc424(s: &str) -> Result<Self, Error> {
-        let record: Arinc424Record = s.parse()?;
+        Self::try_from_arinc424_filtered(s, &Filter::default())
+    }
 
-        Ok(Self {
-            airports: record.airports,
-            airspaces: Vec::new(),
-            waypoints: record.waypoints,
-            locations: record.locations,
-            cycle: record.cycle,
-        })
+    /// Creates navigation data from an ARINC 424 string with only the records
+    /// that pass the `filter`.
+    ///
+    /// The declination of records without a stated magnetic variation is
+    /// evaluated at the effective date of the newest AIRAC cycle of the
+    /// records. Records are oriented to true north if the World Magnetic
+    /// Model doesn't cover that date.
+    pub fn try_from_arinc424_filtered(s: &str, filter: &Filter) -> Result<Self, Error> {
+        Arinc424Record::parse(s, filter, None).map(Self::from)
+    }
+
+    /// Creates navigation data like [`try_from_arinc424_filtered`] but
+    /// evaluates the declination of records without a stated magnetic
+    /// variation at the `epoch`.
+    ///
+    /// [`try_from_arinc424_filtered`]: NavigationData::try_from_arinc424_filtered
+    pub fn try_from_arinc424_at(s: &str, filter: &Filter, epoch: NaiveDate) -> Result<Self, Error> {
+        Arinc424Record::parse(s, filter, Some(epoch)).map(Self::from)
+    }
+
+    /// Creates navigation data from an ARINC 424 string with only the records
+    /// that pass the `filter`, but builds airports and waypoints on first
+    /// access.
+    ///
+    /// Loading indexes only the position of each record within `s`, which is
+    /// kept to build an airport or waypoint once it's found, iterated or
+    /// returned as nearest. Airways and procedures are loaded as usual.
+    pub fn try_from_arinc424_lazy(s: impl Into<Rc<str>>, filter: &Filter) -> Result<Self, Error> {
+        Arinc424Record::parse_lazy(s.into(), filter, None).map(Self::from)
+    }
+
+    /// Creates navigation data like [`try_from_arinc424_lazy`] but evaluates
+    /// the declination of records without a stated magnetic variation at the
+    /// `epoch`.
+    ///
+    /// [`try_from_arinc424_lazy`]: NavigationData::try_from_arinc424_lazy
+    pub fn try_from_arinc424_lazy_at(
+        s: impl Into<Rc<str>>,
+        filter: &Filter,
+        epoch: NaiveDate,
+    ) -> Result<Self, Error> {
+        Arinc424Record::parse_lazy(s.into(), filter, Some(epoch)).map(Self::from)
     }
 
     /// Creates navigation data from an OpenAir string.
     pub fn try_from_openair(s: &str) -> Result<Self, Error> {
-        let record: OpenAirRecord = s.parse()?;
+        Self::try_from_openair_filtered(s, &Filter::default())
+    }
+
+    /// Creates navigation data from an OpenAir string with only the airspaces
+    /// that pass the `filter`.
+    pub fn try_from_openair_filtered(s: &str, filter: &Filter) -> Result<Self, Error> {
+        let record = OpenAirRecord::parse(s, filter)?;
 
         Ok(Self {
-            airports: Vec::new(),
-            airspaces: record.airspaces,
-            waypoints: Vec::new(),
+            airports: Records::default(),
+            airspaces: record.airspaces.into_iter().map(Rc::new).collect(),
+            waypoints: Records::default(),
+            airways: Rc::default(),
+            procedures: Rc::default(),
             locations: Vec::new(),
             cycle: None,
+            epoch: None,
+            index: Derived::default(),
+            geometry: Derived::default(),
+            partitions: Derived::default(),
+            spatial: Derived::default(),
         })
     }
 
@@ -100,30 +200,704 @@ impl NavigationData {
         self.cycle.as_ref()
     }
 
-    pub fn at(&self, point: &Coordinate) -> Vec<&Airspace> {
-        self.airspaces
+    /// Returns the airway network whose fixes refer to the [waypoints].
+    ///
+    /// [waypoints]: NavigationData::waypoint
+    pub fn airways(&self) -> &Airways {
+        &self.airways
+    }
+
+    /// Returns the terminal procedures whose fixes refer to the [waypoints].
+    ///
+    /// [waypoints]: NavigationData::waypoint
+    pub fn procedures(&self) -> &Procedures {
+        &self.procedures
+    }
+
+    /// Returns an iterator over all airports.
+    pub fn airports(&self) -> impl Iterator<Item = &Rc<Airport>> {
+        self.airports.iter()
+    }
+
+    /// Returns an iterator over all waypoints.
+    pub fn waypoints(&self) -> impl Iterator<Item = &Rc<Waypoint>> {
+        self.waypoints.iter()
+    }
+
+    /// Returns an iterator over all airspaces.
+    pub fn airspaces(&self) -> impl Iterator<Item = &Airspace> {
+        self.airspaces.iter().map(Rc::as_ref)
+    }
+
+    /// Returns an iterator over the airports at the `location`.
+    pub fn airports_in(&self, location: LocationIndicator) -> impl Iterator<Item = &Rc<Airport>> {
+        self.location_partitions()
+            .airports
+            .get(Some(location))
             .iter()
-            .filter(|airspace| airspace.polygon.contains(point))
-            .collect()
+            .filter_map(|&i| self.airports.get(i as usize))
     }
 
-    pub fn find(&self, ident: &str) -> Option<NavAid> {
-        self.waypoints
+    /// Returns an iterator over the waypoints at the `location`.
+    pub fn waypoints_in(&self, location: LocationIndicator) -> impl Iterator<Item = &Rc<Waypoint>> {
+        self.location_partitions()
+            .waypoints
+            .get(Some(location))
             .iter()
-            .find(|&wp| wp.ident() == ident)
+            .filter_map(|&i| self.waypoints.get(i as usize))
+    }
+
+    /// Returns the waypoint at the `index`, e.g. a fix of an airway.
+    pub fn waypoint(&self, index: usize) -> Option<&Rc<Waypoint>> {
+        self.waypoints.get(index)
+    }
+
+    /// Returns the airport at the `index`, e.g. the airport of a procedure.
+    pub fn airport(&self, index: usize) -> Option<&Rc<Airport>> {
+        self.airports.get(index)
+    }
+
+    /// Returns the procedure with the `ident` of the `airport`.
+    pub fn procedure(&self, airport: &Airport, ident: &str) -> Option<&Procedure> {
+        self.procedures.find(ident).find(|procedure| {
+            self.airports
+                .get(procedure.airport())
+                .is_some_and(|aprt| aprt.icao_ident == airport.icao_ident)
+        })
+    }
+
+    /// Returns the fixes when flying the `procedure`.
+    ///
+    /// The procedure is expanded with the runway transition of the runway with
+    /// the `designator` and the enroute or approach `transition`. An
+    /// [`UnknownTransition`] error is returned if the procedure has no such
+    /// transition.
+    ///
+    /// [`UnknownTransition`]: Error::UnknownTransition
+    pub fn procedure_fixes(
+        &self,
+        procedure: &Procedure,
+        designator: Option<&str>,
+        transition: Option<&str>,
+    ) -> Result<Vec<NavAid>, Error> {
+        let fixes = self
+            .procedures
+            .expand(procedure, designator, transition)
+            .ok_or_else(|| Error::UnknownTransition {
+                procedure: procedure.ident().to_string(),
+                transition: transition.unwrap_or_default().to_string(),
+            })?;
+
+        Ok(fixes
+            .into_iter()
+            .filter_map(|fix| self.waypoints.get(fix))
             .map(|wp| NavAid::Waypoint(Rc::clone(wp)))
-            .or(self
-                .airports
-                .iter()
-                .find(|&aprt| aprt.ident() == ident)
-                .map(|aprt| NavAid::Airport(Rc::clone(aprt))))
+            .collect())
+    }
+
+    /// Returns the airspaces that contain the `point`.
+    pub fn at(&self, point: &Coordinate) -> Vec<&Airspace> {
+        self.airspace_geometry()
+            .at(point)
+            .map(|i| &*self.airspaces[i])
+            .collect()
+    }
+
+    /// Returns the airspaces that are entered or touched by the line from
+    /// `from` to `to` at the `level`, e.g. by a leg of a route.
+    pub fn crossing(
+        &self,
+        from: &Coordinate,
+        to: &Coordinate,
+        level: VerticalDistance,
+    ) -> Vec<&Airspace> {
+        self.airspace_geometry()
+            .crossing(from, to, level)
+            .map(|i| &*self.airspaces[i])
+            .collect()
+    }
+
+    /// Returns the airspaces that are entered within the `look_ahead`
+    /// distance when flying from the `position` along the `track` at the
+    /// `level`, or whose boundary comes within the `margin` of the track,
+    /// ordered by the along-track distance to their boundary.
+    ///
+    /// Each airspace is returned with the closest distance between its
+    /// boundary and the track, which is zero if it's entered, and the time
+    /// to the boundary estimated with the ground speed `gs`. Airspaces that
+    /// already contain the `position` are not returned. The query visits only
+    /// the airspaces of the cells around the track and their edges if their
+    /// bounds overlap it, thus it can be repeated on each position update.
+    pub fn proximity(
+        &self,
+        position: &Coordinate,
+        track: Angle,
+        gs: Speed,
+        look_ahead: Length,
+        margin: Length,
+        level: VerticalDistance,
+    ) -> Vec<AirspaceEntry<'_>> {
+        let geometry = self.airspace_geometry();
+        let ahead = position.destination(track, look_ahead);
+        let inside: Vec<usize> = geometry.at(position).collect();
+
+        // the closest distance to the track and its along-track distance
+        let mut closest: HashMap<usize, (f32, f32)> = HashMap::new();
+        let mut offset = 0.0;
+        for part in Corridor::along(position, &ahead, margin) {
+            for (i, along, dist) in geometry.approaching(&part, level) {
+                let best = closest.entry(i).or_insert((0.0, f32::INFINITY));
+                if dist < best.1 {
+                    *best = (offset + along, dist);
+                }
+            }
+            offset += part.len();
+        }
+
+        let mut entries: Vec<AirspaceEntry<'_>> = closest
+            .into_iter()
+            .filter(|(i, _)| !inside.contains(i))
+            .map(|(i, (along, dist))| {
+                let along = Length::nm(along);
+                AirspaceEntry {
+                    airspace: &*self.airspaces[i],
+                    dist: along,
+                    clearance: Length::nm(dist),
+                    ete: (gs.to_si() > 0.0).then(|| along / gs),
+                }
+            })
+            .collect();
+
+        entries.sort_by(|a, b| a.dist.to_si().total_cmp(&b.dist.to_si()));
+        entries
+    }
+
+    /// Returns the airspaces whose bounds overlap the `bbox`, e.g. to draw
+    /// the airspaces of a map tile.
+    pub fn within(&self, bbox: &BBox) -> Vec<&Airspace> {
+        self.within_classes(bbox, &[])
+    }
+
+    /// Returns the airspaces of the `classes` whose bounds overlap the
+    /// `bbox`, e.g. to draw only the controlled airspaces of a map tile. All
+    /// classes are returned if none are given.
+    ///
+    /// The class is kept next to the bounds, thus, airspaces of other
+    /// classes are skipped without reading the airspace itself.
+    pub fn within_classes(&self, bbox: &BBox, classes: &[AirspaceClass]) -> Vec<&Airspace> {
+        let geometry = self.airspace_geometry();
+        geometry
+            .within(bbox)
+            .filter(|&i| geometry.is_of(i, classes))
+            .map(|i| &*self.airspaces[i])
+            .collect()
+    }
+
+    fn location_partitions(&self) -> &Partitions {
+        self.partitions
+            .get_or_init(|| Partitions::new(&self.airports, &self.waypoints))
+    }
+
+    fn spatial_index(&self) -> &SpatialIndex {
+        self.spatial
+            .get_or_init(|| SpatialIndex::new(&self.airports, &self.waypoints))
+    }
+
+    fn airspace_geometry(&self) -> &AirspaceGeometry {
+        self.geometry
+            .get_or_init(|| AirspaceGeometry::new(&self.airspaces))
+    }
+
+    /// Returns the navigation aid with the `ident`.
+    ///
+    /// Waypoints are preferred over airports with the same ident.
+    pub fn find(&self, ident: &str) -> Option<NavAid> {
+        self.search_index()
+            .get(ident)
+            .next()
+            .map(|entry| self.navaid(entry))
+    }
+
+    /// Returns the navigation aid with the `ident` at one of the
+    /// `locations`, e.g. the countries a route passes.
+    ///
+    /// Like [`find`], waypoints are preferred over airports.
+    ///
+    /// [`find`]: NavigationData::find
+    pub fn find_in(&self, ident: &str, locations: &[LocationIndicator]) -> Option<NavAid> {
+        self.find_entry(ident, Some(locations), |_| true)
+    }
+
+    /// Returns the airport with the `ident` at one of the `locations`, or at
+    /// any location if `None`, even if a waypoint has the same ident.
+    pub(crate) fn find_airport(
+        &self,
+        ident: &str,
+        locations: Option<&[LocationIndicator]>,
+    ) -> Option<NavAid> {
+        self.find_entry(ident, locations, |entry| matches!(entry, Entry::Airport(_)))
+    }
+
+    /// Returns the waypoint with the `ident` at one of the `locations`, or at
+    /// any location if `None`.
+    pub(crate) fn find_waypoint(
+        &self,
+        ident: &str,
+        locations: Option<&[LocationIndicator]>,
+    ) -> Option<NavAid> {
+        self.find_entry(ident, locations, |entry| {
+            matches!(entry, Entry::Waypoint(_))
+        })
+    }
+
+    /// Returns the first entry with the `ident` that is of a kind accepted
+    /// by `is_kind` and at one of the `locations`, if any are given.
+    fn find_entry(
+        &self,
+        ident: &str,
+        locations: Option<&[LocationIndicator]>,
+        is_kind: impl Fn(Entry) -> bool,
+    ) -> Option<NavAid> {
+        let partitions = locations.map(|_| self.location_partitions());
+        self.search_index()
+            .get(ident)
+            .filter(|&entry| is_kind(entry))
+            .find(|&entry| {
+                let (Some(partitions), Some(locations)) = (partitions, locations) else {
+                    return true;
+                };
+                let (partition, i) = match entry {
+                    Entry::Airport(i) => (&partitions.airports, i),
+                    Entry::Waypoint(i) => (&partitions.waypoints, i),
+                };
+
+                locations
+                    .iter()
+                    .any(|&location| partition.contains(Some(location), i))
+            })
+            .map(|entry| self.navaid(entry))
+    }
+
+    /// Returns up to `limit` navigation aids whose ident or name starts with
+    /// the `query`, ranked by their distance from the `reference` point.
+    ///
+    /// The query is case insensitive and matched against the start of each
+    /// word of an airport's name or waypoint's description, thus `HAM` yields
+    /// the airport `EDDH` named Hamburg. This allows to suggest fixes while
+    /// a route is typed.
+    pub fn search(&self, query: &str, reference: &Coordinate, limit: usize) -> Vec<NavAid> {
+        let query = query.trim().to_uppercase();
+        if query.is_empty() {
+            return Vec::new();
+        }
+
+        self.rank(self.search_index().prefix(&query), reference, limit)
+    }
+
+    /// Returns the airports within the `radius` around the `point` together
+    /// with their distance, ordered by the distance.
+    ///
+    /// The airports are looked up by the spatial index and only the returned
+    /// airports are built.
+    pub fn airports_within(
+        &self,
+        point: &Coordinate,
+        radius: Length,
+    ) -> Vec<(Length, Rc<Airport>)> {
+        let bbox = Corridor::new(point, point, radius).bbox();
+        let mut airports: Vec<(Length, u32)> = self
+            .spatial_index()
+            .within(&bbox)
+            .filter_map(|entry| match entry {
+                Entry::Airport(i) => Some((self.airports.coordinate(i as usize).dist(point), i)),
+                Entry::Waypoint(_) => None,
+            })
+            .filter(|(dist, _)| dist.to_si() <= radius.to_si())
+            .collect();
+
+        airports.sort_unstable_by(|a, b| a.0.to_si().total_cmp(&b.0.to_si()));
+        airports
+            .into_iter()
+            .map(|(dist, i)| {
+                let dist = dist.convert_to(LengthUnit::NauticalMiles);
+                (dist, Rc::clone(&self.airports[i as usize]))
+            })
+            .collect()
+    }
+
+    /// Returns up to `limit` navigation aids nearest to the `point`, ranked by
+    /// their distance.
+    pub fn nearest(&self, point: &Coordinate, limit: usize) -> Vec<NavAid> {
+        let entries = self
+            .waypoints
+            .indices()
+            .map(|i| Entry::Waypoint(i as u32))
+            .chain(self.airports.indices().map(|i| Entry::Airport(i as u32)));
+
+        self.rank(entries, point, limit)
+    }
+
+    /// Returns up to `limit` of the `entries` ranked by their distance from
+    /// the `reference` point. Only the returned entries are built.
+    ///
+    /// The entries are streamed through a heap of the `limit` nearest entries
+    /// so far, thus, ranking takes O(n log limit) time and O(limit) memory
+    /// even for a prefix that matches most of the data. Entries that are
+    /// streamed more than once are ranked once.
+    fn rank(
+        &self,
+        entries: impl Iterator<Item = Entry>,
+        reference: &Coordinate,
+        limit: usize,
+    ) -> Vec<NavAid> {
+        if limit == 0 {
+            return Vec::new();
+        }
+
+        // the bits of a positive float are ordered like the float itself
+        let mut nearest: BinaryHeap<(u32, Entry)> = BinaryHeap::with_capacity(limit + 1);
+        for entry in entries {
+            let dist = self.coordinate(entry).dist(reference).value().to_bits();
+            let farthest = nearest.peek().map(|&(dist, _)| dist);
+
+            if (nearest.len() == limit && farthest.is_some_and(|farthest| dist >= farthest))
+                || nearest.iter().any(|&(_, e)| e == entry)
+            {
+                continue;
+            }
+
+            nearest.push((dist, entry));
+            if nearest.len() > limit {
+                nearest.pop();
+            }
+        }
+
+        nearest
+            .into_sorted_vec()
+            .into_iter()
+            .map(|(_, entry)| self.navaid(entry))
+            .collect()
+    }
+
+    fn search_index(&self) -> &SearchIndex {
+        self.index
+            .get_or_init(|| SearchIndex::new(&self.airports, &self.waypoints))
+    }
+
+    fn navaid(&self, entry: Entry) -> NavAid {
+        match entry {
+            Entry::Airport(i) => NavAid::Airport(Rc::clone(&self.airports[i as usize])),
+            Entry::Waypoint(i) => NavAid::Waypoint(Rc::clone(&self.waypoints[i as usize])),
+        }
+    }
+
+    fn coordinate(&self, entry: Entry) -> Coordinate {
+        match entry {
+            Entry::Airport(i) => self.airports.coordinate(i as usize),
+            Entry::Waypoint(i) => self.waypoints.coordinate(i as usize),
+        }
+    }
+
+    /// Returns the fixes along the `airway` from the fix `from` to the fix
+    /// with the ident `to`.
+    ///
+    /// The `from` fix is not part of the returned fixes but the `to` fix is.
+    /// If airways of different areas share the ident, the first one on which
+    /// both fixes are located is taken. An [`UnknownAirwaySegment`] error is
+    /// returned if either fix is not located on the airway.
+    ///
+    /// [`UnknownAirwaySegment`]: Error::UnknownAirwaySegment
+    pub fn airway_segment(
+        &self,
+        from: &NavAid,
+        airway: &str,
+        to: &str,
+    ) -> Result<Vec<NavAid>, Error> {
+        let err = || Error::UnknownAirwaySegment {
+            airway: airway.to_string(),
+            from: from.ident(),
+            to: to.to_string(),
+        };
+
+        // the position on the airway of a waypoint with the ident, resolved
+        // through the indices without building the waypoints on the airway;
+        // removed waypoints are not in the search index
+        let seq = |index: usize, ident: &str| {
+            self.search_index()
+                .get(ident)
+                .find_map(|entry| match entry {
+                    Entry::Waypoint(i) => self
+                        .airways
+                        .positions(i as usize)
+                        .iter()
+                        .find(|pos| pos.airway() == index)
+                        .map(AirwayPosition::seq),
+                    _ => None,
+                })
+        };
+
+        let from = from.ident();
+        self.airways
+            .find(airway)
+            .find_map(|index| match (seq(index, &from), seq(index, to)) {
+                (Some(from), Some(to)) if from != to => Some(
+                    self.airways
+                        .segment(index, from, to)
+                        .into_iter()
+                        .filter_map(|fix| self.waypoints.get(fix))
+                        .map(|wp| NavAid::Waypoint(Rc::clone(wp)))
+                        .collect(),
+                ),
+                _ => None,
+            })
+            .ok_or_else(err)
     }
 
     /// Appends other NavigationData.
+    ///
+    /// The records are appended as they are, even if they are already within
+    /// this data. Use [`merge`] to merge overlapping data.
+    ///
+    /// [`merge`]: NavigationData::merge
     pub fn append(&mut self, mut other: NavigationData) {
-        self.airports.append(&mut other.airports);
+        let airport_offset = self.airports.len();
+        let fix_offset = self.waypoints.len();
+        self.airports.append(other.airports);
         self.airspaces.append(&mut other.airspaces);
-        self.waypoints.append(&mut other.waypoints);
+        self.waypoints.append(other.waypoints);
+        Rc::make_mut(&mut self.airways).append(
+            Rc::unwrap_or_clone(other.airways),
+            fix_offset,
+            self.waypoints.len(),
+        );
+        Rc::make_mut(&mut self.procedures).append(
+            Rc::unwrap_or_clone(other.procedures),
+            airport_offset,
+            fix_offset,
+        );
+        self.merge_locations_and_cycle(&other.locations, other.cycle);
+        self.epoch = self.epoch.or(other.epoch);
+        self.reset_derived();
+    }
+
+    /// Merges other NavigationData and returns the conflicts.
+    ///
+    /// Airports and waypoints that are within both data are identified by
+    /// their ident, region and location and merged into one record. If both
+    /// records differ, the record of the newer AIRAC cycle is kept. Records
+    /// that differ but are of the same cycle are reported as
+    /// [`MergeConflict`] and the existing record is kept. Airways of the same
+    /// ident and area are united by the sequence numbers of their fixes, thus,
+    /// the parts of an airway stated by the data of different countries are
+    /// joined, and differences are resolved by the cycle of each airway.
+    /// Procedures are merged alike by the cycle of each data. Airspaces that
+    /// are within both data are kept once.
+    pub fn merge(&mut self, other: NavigationData) -> Vec<MergeConflict> {
+        let resolution = Resolution::new(self.cycle, other.cycle);
+
+        let (airport_remap, airport_conflicts) = self.airports.merge(other.airports);
+        let (fix_remap, fix_conflicts) = self.waypoints.merge(other.waypoints);
+
+        let mut airspaces: HashMap<&str, Vec<&Rc<Airspace>>> = HashMap::new();
+        for airspace in &self.airspaces {
+            airspaces.entry(&airspace.name).or_default().push(airspace);
+        }
+        let new_airspaces: Vec<Rc<Airspace>> = other
+            .airspaces
+            .into_iter()
+            .filter(|airspace| {
+                airspaces
+                    .get(airspace.name.as_str())
+                    .is_none_or(|existing| !existing.contains(&airspace))
+            })
+            .collect();
+        self.airspaces.extend(new_airspaces);
+
+        let airway_conflicts = Rc::make_mut(&mut self.airways).merge(
+            Rc::unwrap_or_clone(other.airways),
+            |fix| fix_remap[fix as usize],
+            self.waypoints.len(),
+        );
+        let procedure_conflicts = Rc::make_mut(&mut self.procedures).merge(
+            Rc::unwrap_or_clone(other.procedures),
+            |airport| airport_remap[airport as usize],
+            |fix| fix_remap[fix as usize],
+            resolution,
+        );
+
+        self.merge_locations_and_cycle(&other.locations, other.cycle);
+        self.epoch = self.epoch.or(other.epoch);
+        self.reset_derived();
+
+        airport_conflicts
+            .into_iter()
+            .map(|i| MergeConflict::Airport(self.airports.ident(i as usize)))
+            .chain(
+                fix_conflicts
+                    .into_iter()
+                    .map(|i| MergeConflict::Waypoint(self.waypoints.ident(i as usize))),
+            )
+            .chain(airway_conflicts.into_iter().map(MergeConflict::Airway))
+            .chain(procedure_conflicts.into_iter().map(|(airport, ident)| {
+                MergeConflict::Procedure {
+                    airport: self.airports.ident(airport),
+                    ident,
+                }
+            }))
+            .collect()
+    }
+
+    /// Applies the `delta` of the next AIRAC cycle.
+    ///
+    /// Added, modified and removed airports, runways and waypoints are
+    /// updated in place together with the indices, thus, applying a delta
+    /// takes time proportional to its size rather than the size of the data.
+    /// Airways and procedures skip removed waypoints, since they aren't part
+    /// of a delta. Like when [unloading], removed records are dropped for
+    /// good once they make up more than a quarter of the data. Afterwards,
+    /// the data is of the [cycle] of the delta.
+    ///
+    /// A [`DeltaHashMismatch`] error is returned if the [content hash] of the
+    /// updated data doesn't match the delta's hash and an [`UnknownIdent`]
+    /// error if a modified or removed record is unknown. In both cases the
+    /// data is left unchanged.
+    ///
+    /// [`DeltaHashMismatch`]: Error::DeltaHashMismatch
+    /// [content hash]: NavigationData::content_hash
+    /// [`UnknownIdent`]: Error::UnknownIdent
+    /// [unloading]: NavigationData::unload
+    /// [cycle]: Delta::cycle
+    pub fn apply_delta(&mut self, delta: &Delta) -> Result<(), Error> {
+        delta::apply(self, delta)?;
+        self.compact_if_sparse();
+        Ok(())
+    }
+
+    /// Returns a hash of the content of the airports and waypoints.
+    ///
+    /// The hash is taken from the raw records, thus, it doesn't depend on
+    /// the order of the records nor on the date at which the declination is
+    /// evaluated and is stable across platforms. It can be used to verify
+    /// that applying a [`Delta`] yields the same data as loading the next
+    /// cycle. The hash is kept up to date by every change, so it's returned
+    /// without building any record.
+    pub fn content_hash(&self) -> u64 {
+        self.airports.hash().wrapping_add(self.waypoints.hash())
+    }
+
+    /// Unloads the airports and waypoints at the `location`.
+    ///
+    /// The records are removed in place together with their indices, thus,
+    /// a whole country can be unloaded and reloaded from newer data by
+    /// [merging] it without rebuilding the rest. Airways and procedures skip
+    /// the removed waypoints. Airspaces aren't affected since they don't
+    /// state a location. Once removed records make up more than a quarter of
+    /// the data, they are dropped for good.
+    ///
+    /// [merging]: NavigationData::merge
+    pub fn unload(&mut self, location: LocationIndicator) {
+        let partitions = self.location_partitions();
+        let airports = partitions.airports.get(Some(location)).to_vec();
+        let waypoints = partitions.waypoints.get(Some(location)).to_vec();
+
+        delta::remove(self, &airports, &waypoints);
+        self.locations.retain(|l| *l != location);
+        self.compact_if_sparse();
+    }
+
+    /// Compacts the data if more than a quarter of the airports or waypoints
+    /// are removed.
+    fn compact_if_sparse(&mut self) {
+        let sparse = |removed: usize, len: usize| removed * 4 > len;
+        if sparse(self.airports.removed_count(), self.airports.len())
+            || sparse(self.waypoints.removed_count(), self.waypoints.len())
+        {
+            self.compact();
+        }
+    }
+
+    /// Drops the removed airports and waypoints and maps the indices of the
+    /// airways, procedures and partitions to the remaining records.
+    fn compact(&mut self) {
+        let airports = self.airports.compact();
+        let waypoints = self.waypoints.compact();
+
+        Rc::make_mut(&mut self.airways)
+            .compact(|fix| waypoints[fix as usize], self.waypoints.len());
+        Rc::make_mut(&mut self.procedures).compact(
+            |airport| airports[airport as usize],
+            |fix| waypoints[fix as usize],
+        );
+
+        if let Some(partitions) = self.partitions.get_mut() {
+            partitions.airports.remap(&airports);
+            partitions.waypoints.remap(&waypoints);
+        }
+
+        // the content is unchanged, thus, only the indices are derived again
+        self.index.reset();
+        self.spatial.reset();
+    }
+
+    /// Drops the values that are derived from the data.
+    fn reset_derived(&mut self) {
+        self.index.reset();
+        self.geometry.reset();
+        self.partitions.reset();
+        self.spatial.reset();
+    }
+
+    /// Shares the records that are unchanged in one of the `bases`, e.g. the
+    /// records that didn't change between two cycles.
+    ///
+    /// Airports and waypoints are shared by their key and airspaces by their
+    /// name if they are equal. Airways and procedures refer to the waypoints
+    /// by their index, thus, they are shared as a whole if they are equal.
+    pub(crate) fn share(&mut self, bases: &[&NavigationData]) {
+        let airports: Vec<_> = bases.iter().map(|base| &base.airports).collect();
+        let waypoints: Vec<_> = bases.iter().map(|base| &base.waypoints).collect();
+        self.airports.share(&airports);
+        self.waypoints.share(&waypoints);
+
+        let mut airspaces: HashMap<&str, Vec<&Rc<Airspace>>> = HashMap::new();
+        for airspace in bases.iter().flat_map(|base| &base.airspaces) {
+            airspaces.entry(&airspace.name).or_default().push(airspace);
+        }
+        for airspace in &mut self.airspaces {
+            let shared = airspaces
+                .get(airspace.name.as_str())
+                .and_then(|candidates| candidates.iter().find(|&&c| c == airspace));
+            if let Some(&shared) = shared {
+                *airspace = Rc::clone(shared);
+            }
+        }
+
+        if let Some(base) = bases.iter().find(|base| base.airways == self.airways) {
+            self.airways = Rc::clone(&base.airways);
+        }
+        if let Some(base) = bases.iter().find(|base| base.procedures == self.procedures) {
+            self.procedures = Rc::clone(&base.procedures);
+        }
+    }
+
+    /// Returns the grid of the declination at the epoch of the data.
+    fn declination_grid(&self) -> Rc<DeclinationGrid> {
+        declination_grid(self.epoch.or_else(|| epoch(self.cycle)))
+    }
+
+    fn merge_locations_and_cycle(
+        &mut self,
+        locations: &[LocationIndicator],
+        cycle: Option<AiracCycle>,
+    ) {
+        for location in locations {
+            if !self.locations.contains(location) {
+                self.locations.push(*location);
+            }
+        }
+
+        // like when parsing, the data is of the cycle of its newest record
+        self.cycle = self.cycle.max(cycle);
     }
 
     #[deprecated(
@@ -133,13 +907,30 @@ impl NavigationData {
     pub fn read(&mut self, s: &str, fmt: InputFormat) -> Result<(), Error> {
         match fmt {
             InputFormat::Arinc424 => {
-                let mut record = s.parse::<Arinc424Record>()?;
-                self.airports.append(&mut record.airports);
-                self.waypoints.append(&mut record.waypoints);
+                let record = s.parse::<Arinc424Record>()?;
+                let airport_offset = self.airports.len();
+                let fix_offset = self.waypoints.len();
+                self.airports.append(record.airports);
+                self.waypoints.append(record.waypoints);
+                Rc::make_mut(&mut self.airways).append(
+                    record.airways,
+                    fix_offset,
+                    self.waypoints.len(),
+                );
+                Rc::make_mut(&mut self.procedures).append(
+                    record.procedures,
+                    airport_offset,
+                    fix_offset,
+                );
+                self.merge_locations_and_cycle(&record.locations, record.cycle);
+                self.epoch = self.epoch.or(record.epoch);
+                self.reset_derived();
             }
             InputFormat::OpenAir => {
-                let mut record = s.parse::<OpenAirRecord>()?;
-                self.airspaces.append(&mut record.airspaces);
+                let record = s.parse::<OpenAirRecord>()?;
+                self.airspaces
+                    .extend(record.airspaces.into_iter().map(Rc::new));
+                self.geometry.reset();
             }
         };
 
@@ -147,10 +938,48 @@ impl NavigationData {
     }
 }
 
+/// Returns the date at which the declination of records of the `cycle` is
+/// evaluated, which is the effective date of the cycle.
+fn epoch(cycle: Option<AiracCycle>) -> Option<NaiveDate> {
+    cycle?.effective_date()
+}
+
+/// Returns the grid of the declination at the `epoch`.
+///
+/// Without an epoch, e.g. of data without a cycle, and for dates beyond the
+/// calendar the grid is of a date the model doesn't cover. Thus, records
+/// without a stated variation are oriented to true north rather than
+/// depending on the date they're loaded at.
+fn declination_grid(epoch: Option<NaiveDate>) -> Rc<DeclinationGrid> {
+    let date = epoch
+        .and_then(|epoch| time::Date::from_ordinal_date(epoch.year(), epoch.ordinal() as u16).ok())
+        .unwrap_or(time::Date::MIN);
+    DeclinationGrid::cached(date)
+}
+
+impl From<Arinc424Record> for NavigationData {
+    fn from(record: Arinc424Record) -> Self {
+        Self {
+            airports: record.airports,
+            airspaces: Vec::new(),
+            waypoints: record.waypoints,
+            airways: Rc::new(record.airways),
+            procedures: Rc::new(record.procedures),
+            locations: record.locations,
+            cycle: record.cycle,
+            epoch: record.epoch,
+            index: Derived::default(),
+            geometry: Derived::default(),
+            partitions: Derived::default(),
+            spatial: Derived::default(),
+        }
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use crate::geom::Polygon;
-    use crate::VerticalDistance;
+    use crate::measurements::LengthUnit;
 
     use super::*;
 
@@ -160,7 +989,7 @@ mod tests {
         let outside = coord!(53.04892, 8.90907);
 
         let nd = NavigationData {
-            airspaces: vec![Airspace {
+            airspaces: vec![Rc::new(Airspace {
                 name: String::from("TMA BREMEN A"),
                 class: AirspaceClass::D,
                 ceiling: VerticalDistance::Fl(65),
@@ -172,14 +1001,417 @@ mod tests {
                     (52.96889, 8.982222),
                     (53.10111, 8.974999)
                 ],
-            }],
-            airports: Vec::new(),
-            waypoints: Vec::new(),
+            })],
+            airports: Records::default(),
+            waypoints: Records::default(),
+            airways: Rc::default(),
+            procedures: Rc::default(),
             locations: vec!["ED".try_into().expect("ED should be a valid location")],
             cycle: None,
+            epoch: None,
+            index: Derived::default(),
+            geometry: Derived::default(),
+            partitions: Derived::default(),
+            spatial: Derived::default(),
         };
 
-        assert_eq!(nd.at(&inside), vec![&nd.airspaces[0]]);
+        assert_eq!(nd.at(&inside), vec![&*nd.airspaces[0]]);
         assert!(nd.at(&outside).is_empty());
     }
+
+    #[test]
+    fn airspace_ahead_on_track() {
+        let nd = NavigationData::try_from_openair(
+            r#"AC D
+AN TMA BREMEN A
+AH FL 65
+AL 1500msl
+DP 53:06:04 N 8:58:30 E
+DP 53:06:10 N 9:04:45 E
+DP 52:58:13 N 9:05:04 E
+DP 52:58:08 N 8:58:56 E
+DP 53:06:04 N 8:58:30 E
+"#,
+        )
+        .expect("airspace should be valid");
+        let position = coord!(53.04892, 8.90907);
+        let proximity = |track, level| {
+            nd.proximity(
+                &position,
+                track,
+                Speed::kt(120.0),
+                Length::nm(10.0),
+                Length::nm(1.0),
+                level,
+            )
+        };
+
+        let entries = proximity(Angle::t(90.0), VerticalDistance::Msl(2500));
+        assert_eq!(entries.len(), 1);
+        assert_eq!(entries[0].airspace.name, "TMA BREMEN A");
+        assert_eq!(*entries[0].clearance.value(), 0.0);
+        assert_eq!(
+            entries[0]
+                .dist
+                .convert_to(LengthUnit::NauticalMiles)
+                .value()
+                .round(),
+            2.0
+        );
+        assert_eq!(entries[0].ete.map(|ete| ete.to_si() / 60), Some(1));
+
+        // the airspace is behind us or below its floor
+        assert!(proximity(Angle::t(270.0), VerticalDistance::Msl(2500)).is_empty());
+        assert!(proximity(Angle::t(90.0), VerticalDistance::Msl(1000)).is_empty());
+
+        // the airspace is skirted about 2.5 NM to the right
+        assert!(proximity(Angle::t(0.0), VerticalDistance::Msl(2500)).is_empty());
+        let skirted = nd.proximity(
+            &position,
+            Angle::t(0.0),
+            Speed::kt(120.0),
+            Length::nm(10.0),
+            Length::nm(3.0),
+            VerticalDistance::Msl(2500),
+        );
+        assert_eq!(skirted.len(), 1);
+        assert_eq!(
+            skirted[0]
+                .clearance
+                .convert_to(LengthUnit::NauticalMiles)
+                .value()
+                .round(),
+            2.0
+        );
+    }
+
+    const ARINC_424_RECORDS: &'static str = r#"SEURP EDDHEDA        0        N N53374900E009591762E002000053                   P    MWGE    HAMBURG                       356462409
+SEURP EDDHEDGRW33    0120273330 N53374300E009595081                          151                                           124362502
+SEURPCEDDHED N1    ED0    V     N53482105E010015451                                 WGE           NOVEMBER1                359892409
+SEURP EDHFEDA        0        N N53593300E009343600E000000082                   P    MWGE    ITZEHOE/HUNGRIGER WOLF        320782409
+SEURP EDDFEDA        0        N N50020000E008340000E000000364                   P    MWGE    FRANKFURT MAIN                356472409
+"#;
+
+    #[test]
+    fn search_ranked_by_distance() {
+        let nd =
+            NavigationData::try_from_arinc424(ARINC_424_RECORDS).expect("records should be valid");
+
+        let idents = |query, reference| -> Vec<String> {
+            nd.search(query, &reference, 5)
+                .iter()
+                .map(|navaid| navaid.ident())
+                .collect()
+        };
+
+        assert_eq!(
+            idents("ed", coord!(53.99, 9.57)),
+            vec!["EDHF", "EDDH", "EDDF"]
+        );
+        assert_eq!(idents("EDD", coord!(50.0, 8.5)), vec!["EDDF", "EDDH"]);
+        assert_eq!(idents("wolf", coord!(53.63, 9.99)), vec!["EDHF"]);
+        assert_eq!(idents("nov", coord!(53.63, 9.99)), vec!["DHN1"]);
+        assert_eq!(nd.search("ED", &coord!(53.63, 9.99), 1).len(), 1);
+
+        // only the nearest entries are kept while the matches are streamed
+        let nearest: Vec<String> = nd
+            .search("E", &coord!(53.99, 9.57), 2)
+            .iter()
+            .map(|navaid| navaid.ident())
+            .collect();
+        assert_eq!(nearest, vec!["EDHF", "EDDH"]);
+    }
+
+    #[test]
+    fn loads_filtered_records() {
+        let filter = Filter::new().bbox(
+            BBox::new(&[coord!(53.5, 9.5), coord!(54.0, 10.5)]).expect("bbox should be some"),
+        );
+
+        let nd = NavigationData::try_from_arinc424_filtered(ARINC_424_RECORDS, &filter)
+            .expect("records should be valid");
+
+        assert!(nd.find("EDDH").is_some());
+        assert!(nd.find("EDHF").is_some());
+        assert!(nd.find("EDDF").is_none());
+    }
+
+    #[test]
+    fn evaluates_declination_at_one_epoch() {
+        let n1 = "SEURPCEDDHED N1    ED0    V     N53482105E010015451                                 WGE           NOVEMBER1                359892409";
+        // a record of a cycle that isn't covered by the model
+        let n2 = n1
+            .replace("N1    ED0", "N2    ED0")
+            .replace("359892409", "359891912");
+        let records = format!("{n1}\n{n2}");
+
+        // the data is of its newest record's cycle, thus, both records are
+        // evaluated at its effective date
+        let grid = declination_grid(epoch(Some(AiracCycle::new(24, 9))));
+        let nd = NavigationData::try_from_arinc424(&records).expect("records should be valid");
+        for ident in ["DHN1", "DHN2"] {
+            let wp = nd.find(ident).expect("waypoint should be found");
+            assert_eq!(Ok(wp.mag_var()), grid.declination(&wp.coordinate()));
+        }
+
+        let epoch = NaiveDate::from_ymd_opt(2025, 1, 1).expect("date should be valid");
+        let grid = declination_grid(Some(epoch));
+        let nd = NavigationData::try_from_arinc424_lazy_at(records, &Filter::default(), epoch)
+            .expect("records should be valid");
+        for ident in ["DHN1", "DHN2"] {
+            let wp = nd.find(ident).expect("waypoint should be found");
+            assert_eq!(Ok(wp.mag_var()), grid.declination(&wp.coordinate()));
+        }
+
+        // outside of the model, records are oriented to true north instead of
+        // being evaluated at the current date
+        let epoch = NaiveDate::from_ymd_opt(1990, 1, 1).expect("date should be valid");
+        let nd = NavigationData::try_from_arinc424_at(n1, &Filter::default(), epoch)
+            .expect("records should be valid");
+        assert_eq!(
+            nd.find("DHN1").map(|wp| wp.mag_var()),
+            Some(MagneticVariation::OrientedToTrueNorth)
+        );
+    }
+
+    #[test]
+    fn lazy_records_equal_built_records() {
+        let built =
+            NavigationData::try_from_arinc424(ARINC_424_RECORDS).expect("records should be valid");
+        let lazy = NavigationData::try_from_arinc424_lazy(ARINC_424_RECORDS, &Filter::default())
+            .expect("records should be valid");
+
+        // only the found airport is built with its runway
+        assert_eq!(lazy.find("EDDH"), built.find("EDDH"));
+        assert_eq!(lazy.airports.built_count(), 1);
+
+        let nearest = |nd: &NavigationData| -> Vec<String> {
+            nd.nearest(&coord!(53.99, 9.57), 2)
+                .iter()
+                .map(|navaid| navaid.ident())
+                .collect()
+        };
+        assert_eq!(nearest(&lazy), vec!["EDHF", "DHN1"]);
+        assert_eq!(nearest(&lazy), nearest(&built));
+
+        assert_eq!(lazy, built);
+    }
+
+    #[test]
+    fn merge_deduplicates_records() {
+        let eddh = "SEURP EDDHEDA        0        N N53374900E009591762E002000053                   P    MWGE    HAMBURG                       356462409";
+        let moved_eddh = "SEURP EDDHEDA        0        N N53374800E009591762E002000053                   P    MWGE    HAMBURG                       356462409";
+        let edhf = "SEURP EDHFEDA        0        N N53593300E009343600E000000082                   P    MWGE    ITZEHOE/HUNGRIGER WOLF        320782409";
+        let nd = |lines: &[&str]| {
+            NavigationData::try_from_arinc424(&lines.join("\n")).expect("records should be valid")
+        };
+
+        let mut merged = nd(&[eddh]);
+        assert!(merged.merge(nd(&[eddh, edhf])).is_empty());
+        assert_eq!(merged.airports().count(), 2);
+        assert_eq!(merged.locations().len(), 1);
+
+        // the same cycle with different content is a conflict
+        assert_eq!(
+            merged.merge(nd(&[moved_eddh])),
+            vec![MergeConflict::Airport(String::from("EDDH"))]
+        );
+        assert_eq!(merged.find("EDDH"), nd(&[eddh]).find("EDDH"));
+
+        // but a newer cycle replaces the record
+        let newer_eddh = moved_eddh.replace("356462409", "356462410");
+        assert!(merged.merge(nd(&[&newer_eddh])).is_empty());
+        assert_eq!(merged.find("EDDH"), nd(&[&newer_eddh]).find("EDDH"));
+        assert_eq!(merged.airports().count(), 2);
+    }
+
+    #[test]
+    fn merge_joins_parts_of_airways() {
+        let lines: Vec<&str> = crate::fixtures::AIRWAY_RECORDS.lines().collect();
+        let nd = |lines: &[&str]| {
+            NavigationData::try_from_arinc424(&lines.join("\n")).expect("records should be valid")
+        };
+
+        // each data states the part of UL126 within its area up to CELLE
+        let mut merged = nd(&[lines[0], lines[1], lines[2], lines[4], lines[5], lines[6]]);
+        assert!(merged
+            .merge(nd(&[lines[2], lines[3], lines[6], lines[7]]))
+            .is_empty());
+        assert_eq!(merged.airways().len(), 1);
+
+        let abben = merged.find("ABBEN").expect("ABBEN should exist");
+        let idents: Vec<String> = merged
+            .airway_segment(&abben, "UL126", "DELTA")
+            .expect("DELTA should be on UL126")
+            .iter()
+            .map(NavAid::ident)
+            .collect();
+        assert_eq!(idents, vec!["BASUM", "CELLE", "DELTA"]);
+    }
+
+    #[test]
+    fn delta_updates_records_in_place() {
+        let lines: Vec<&str> = ARINC_424_RECORDS.lines().collect();
+        let (eddh, rwy33, edhf, eddf) = (lines[0], lines[1], lines[3], lines[4]);
+        let moved_eddh = eddh
+            .replace("N53374900", "N53374800")
+            .replace("356462409", "356462410");
+        let eddw = eddf
+            .replace("EDDF", "EDDW")
+            .replace("FRANKFURT MAIN", "BREMEN        ")
+            .replace("356472409", "356472410");
+
+        let next = NavigationData::try_from_arinc424(
+            &[moved_eddh.as_str(), lines[2], eddf, &eddw].join("\n"),
+        )
+        .expect("records should be valid");
+
+        let mut nd = NavigationData::try_from_arinc424_lazy(ARINC_424_RECORDS, &Filter::default())
+            .expect("records should be valid");
+        // the hash is kept per record, thus, no record is built to verify it
+        nd.content_hash();
+        assert_eq!(nd.airports.built_count(), 0);
+        // the index is built before and updated in place
+        assert!(nd.find("EDHF").is_some());
+
+        let delta = |hash: u64| -> Delta {
+            format!("~{moved_eddh}\n-{rwy33}\n-{edhf}\n+{eddw}\n#{hash:x}")
+                .parse()
+                .expect("delta should be valid")
+        };
+
+        // a mismatching hash leaves the data unchanged
+        let unchanged = nd.clone();
+        assert!(matches!(
+            nd.apply_delta(&delta(0)),
+            Err(Error::DeltaHashMismatch { expected: 0, .. })
+        ));
+        assert_eq!(nd, unchanged);
+        assert_eq!(nd.content_hash(), unchanged.content_hash());
+
+        nd.apply_delta(&delta(next.content_hash()))
+            .expect("delta should match the next cycle");
+        // the data keeps the epoch it's loaded at but advances to the cycle
+        // of the delta
+        assert!(nd.airports().eq(next.airports()));
+        assert!(nd.waypoints().eq(next.waypoints()));
+        assert_eq!(nd.cycle(), Some(&AiracCycle::new(24, 10)));
+        assert_eq!(nd.cycle(), next.cycle());
+        assert_eq!(nd.find("EDDW"), next.find("EDDW"));
+        assert!(nd.find("EDHF").is_none());
+        assert!(nd.search("wolf", &coord!(53.63, 9.99), 5).is_empty());
+        assert_eq!(nd.nearest(&coord!(53.99, 9.57), 1)[0].ident(), "DHN1");
+
+        // removed records are unknown to later deltas
+        assert_eq!(
+            nd.apply_delta(&format!("-{edhf}").parse().expect("delta should be valid")),
+            Err(Error::UnknownIdent(String::from("EDHF")))
+        );
+    }
+
+    #[test]
+    fn unloads_location() {
+        let eh = "SEURP EHAMEHA        0        N N52182000E004454600E002000011                   P    MWGE    SCHIPHOL                      356462409";
+        let mut nd = NavigationData::try_from_arinc424(&format!("{ARINC_424_RECORDS}{eh}"))
+            .expect("records should be valid");
+        let (ed, eh) = (
+            LocationIndicator::new("ED").expect("ED should be a valid location"),
+            LocationIndicator::new("EH").expect("EH should be a valid location"),
+        );
+
+        let idents = |airports: Vec<&Rc<Airport>>| -> Vec<String> {
+            airports.iter().map(|aprt| aprt.ident()).collect()
+        };
+        assert_eq!(idents(nd.airports_in(eh).collect()), vec!["EHAM"]);
+        assert_eq!(nd.waypoints_in(ed).count(), 1);
+        assert!(nd.find_in("EHAM", &[ed]).is_none());
+        assert!(nd.find_in("EHAM", &[ed, eh]).is_some());
+
+        let hash = nd.content_hash();
+        nd.unload(ed);
+        assert_eq!(idents(nd.airports().collect()), vec!["EHAM"]);
+        assert_eq!(nd.airports_in(ed).count(), 0);
+        assert!(nd.find("EDDH").is_none());
+        assert_eq!(nd.locations(), &[eh]);
+        assert_ne!(nd.content_hash(), hash);
+
+        // most airports are removed, thus, their slots are dropped
+        assert_eq!(nd.airports.len(), 1);
+        assert_eq!(nd.nearest(&coord!(52.3, 4.7), 1)[0].ident(), "EHAM");
+
+        // reloading the location restores the data
+        assert!(nd
+            .merge(
+                NavigationData::try_from_arinc424(ARINC_424_RECORDS)
+                    .expect("records should be valid")
+            )
+            .is_empty());
+        assert_eq!(nd.airports().count(), 4);
+        assert_eq!(nd.airports.len(), 4);
+        assert_eq!(nd.content_hash(), hash);
+        assert_eq!(idents(nd.airports_in(eh).collect()), vec!["EHAM"]);
+    }
+
+    #[test]
+    fn records_keep_their_slots_after_unload() {
+        let helen = "SEUREAENRTEH HELEN EH0    C   B N53000000E006000000                                 WGE           HELEN                    000012509";
+        let mut nd = NavigationData::try_from_arinc424(&format!("{helen}\n{ARINC_424_RECORDS}"))
+            .expect("records should be valid");
+        nd.append(
+            NavigationData::try_from_arinc424(crate::fixtures::AIRWAY_RECORDS)
+                .expect("records should be valid"),
+        );
+
+        assert!(nd.find("HELEN").is_some());
+
+        let len = nd.waypoints.len();
+        nd.unload(LocationIndicator::new("EH").expect("EH should be a valid location"));
+        assert!(nd.find("HELEN").is_none());
+        assert_eq!(
+            nd.waypoints.len(),
+            len,
+            "a single waypoint shouldn't compact"
+        );
+
+        // the slots are what the serde impls write and read
+        let mut restored = nd.clone();
+        restored.airports = Records::from_slots(nd.airports.slots().collect::<Vec<_>>());
+        restored.waypoints = Records::from_slots(nd.waypoints.slots().collect::<Vec<_>>());
+        assert_eq!(restored.waypoints.len(), len);
+        assert_eq!(restored.content_hash(), nd.content_hash());
+        assert!(restored.find("HELEN").is_none());
+
+        // the airway still refers to the same waypoints
+        let segment = |nd: &NavigationData| -> Vec<String> {
+            let abben = nd.find("ABBEN").expect("ABBEN should exist");
+            nd.airway_segment(&abben, "UL126", "DELTA")
+                .expect("segment should exist")
+                .iter()
+                .map(|fix| fix.ident())
+                .collect()
+        };
+        assert_eq!(segment(&restored), vec!["BASUM", "CELLE", "DELTA"]);
+        assert_eq!(segment(&restored), segment(&nd));
+    }
+
+    #[test]
+    fn compacting_releases_lazy_lines() {
+        let eh = "SEURP EHAMEHA        0        N N52182000E004454600E002000011                   P    MWGE    SCHIPHOL                      356462409";
+        let mut nd = NavigationData::try_from_arinc424_lazy(
+            format!("{ARINC_424_RECORDS}{eh}"),
+            &Filter::default(),
+        )
+        .expect("records should be valid");
+        let source_len = nd.airports.source_len();
+
+        nd.unload(LocationIndicator::new("ED").expect("ED should be a valid location"));
+        assert_eq!(nd.airports.len(), 1);
+        assert_eq!(nd.airports.built_count(), 0);
+        assert_eq!(nd.airports.source_len(), eh.len() + 1);
+        assert!(nd.airports.source_len() < source_len);
+        assert_eq!(
+            nd.find("EHAM").map(|aprt| aprt.ident()),
+            Some(String::from("EHAM"))
+        );
+    }
 }
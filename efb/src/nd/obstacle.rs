@@ -0,0 +1,327 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::collections::HashMap;
+use std::io::{self, BufRead};
+use std::str::FromStr;
+
+#[cfg(feature = "serde")]
+use serde::{Deserialize, Serialize};
+
+use crate::error::Error;
+use crate::geom::{CellId, Coordinate, Corridor};
+use crate::measurements::{Length, LengthUnit};
+use crate::VerticalDistance;
+
+use super::spatial::LEVEL;
+
+/// An obstacle such as a mast, tower or wind turbine.
+#[derive(Clone, PartialEq, Debug)]
+#[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
+pub struct Obstacle {
+    pub ident: String,
+    pub coordinate: Coordinate,
+    /// The elevation of the obstacle's top above mean sea level.
+    pub elevation: VerticalDistance,
+    /// The height of the obstacle above ground level.
+    pub height: VerticalDistance,
+    pub lighted: bool,
+}
+
+/// Decodes an obstacle from a comma separated line.
+///
+/// The line has the ident, latitude and longitude in decimal degrees,
+/// elevation and height in feet and `Y` if the obstacle is lighted:
+///
+/// ```text
+/// 1234,53.5,9.8,873,820,Y
+/// ```
+impl FromStr for Obstacle {
+    type Err = Error;
+
+    fn from_str(s: &str) -> Result<Self, Self::Err> {
+        let unexpected = || Error::UnexpectedObstacleRecord(s.to_string());
+        let mut fields = s.split(',').map(str::trim);
+        let mut next = || fields.next().ok_or_else(unexpected);
+
+        let ident = next()?.to_string();
+        let latitude = next()?.parse::<f32>().map_err(|_| unexpected())?;
+        let longitude = next()?.parse::<f32>().map_err(|_| unexpected())?;
+        let elevation = next()?.parse::<u16>().map_err(|_| unexpected())?;
+        let height = next()?.parse::<u16>().map_err(|_| unexpected())?;
+        let lighted = matches!(next()?, "Y" | "y");
+
+        if !(-90.0..=90.0).contains(&latitude) || !(-180.0..=180.0).contains(&longitude) {
+            return Err(unexpected());
+        }
+
+        Ok(Self {
+            ident,
+            coordinate: Coordinate::new(latitude, longitude),
+            elevation: VerticalDistance::Msl(elevation),
+            height: VerticalDistance::Agl(height),
+            lighted,
+        })
+    }
+}
+
+/// An obstacle near a leg compared against the leg's level.
+#[derive(Clone, PartialEq, Debug)]
+pub struct ObstacleClearance<'a> {
+    pub obstacle: &'a Obstacle,
+    /// The lateral distance of the obstacle from the leg.
+    pub dist: Length,
+    /// The vertical distance from the obstacle's top to the leg's level,
+    /// which is negative if the level is below the top. It's `None` if the
+    /// leg has no level with a datum of mean sea level.
+    pub clearance: Option<Length>,
+}
+
+/// A store of obstacles with a spatial index.
+///
+/// The obstacles are indexed by [cells], thus a query visits only the
+/// obstacles in the cells that cover the queried area.
+/// Obstacles are added one by one, e.g. while reading a large dataset line by
+/// line, without keeping the dataset in memory.
+///
+/// [cells]: CellId
+#[derive(Clone, Debug, Default)]
+pub struct Obstacles {
+    obstacles: Vec<Obstacle>,
+    cells: HashMap<CellId, Vec<u32>>,
+}
+
+impl Obstacles {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Reads the obstacles of each line from the `reader`.
+    ///
+    /// Empty lines and lines that start with `#` are skipped. See
+    /// [`Obstacle::from_str`] for the format of a line.
+    ///
+    /// # Errors
+    ///
+    /// Returns the I/O error of the `reader` or an error of kind
+    /// [`InvalidData`] with the [`UnexpectedObstacleRecord`] if a line is
+    /// malformed. The obstacles read up to that line are kept.
+    ///
+    /// [`InvalidData`]: io::ErrorKind::InvalidData
+    /// [`UnexpectedObstacleRecord`]: Error::UnexpectedObstacleRecord
+    pub fn read(&mut self, reader: impl BufRead) -> io::Result<()> {
+        for line in reader.lines() {
+            let line = line?;
+            let line = line.trim();
+            if line.is_empty() || line.starts_with('#') {
+                continue;
+            }
+
+            let obstacle = line
+                .parse::<Obstacle>()
+                .map_err(|e| io::Error::new(io::ErrorKind::InvalidData, e))?;
+            self.push(obstacle);
+        }
+
+        Ok(())
+    }
+
+    pub fn push(&mut self, obstacle: Obstacle) {
+        let i = self.obstacles.len() as u32;
+        self.cells
+            .entry(CellId::new(&obstacle.coordinate, LEVEL))
+            .or_default()
+            .push(i);
+        self.obstacles.push(obstacle);
+    }
+
+    pub fn len(&self) -> usize {
+        self.obstacles.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.obstacles.is_empty()
+    }
+
+    pub fn iter(&self) -> impl Iterator<Item = &Obstacle> {
+        self.obstacles.iter()
+    }
+
+    /// Returns the obstacles within the `buffer` to either side of the great
+    /// circle from `from` to `to` together with their distance from it.
+    pub fn near(
+        &self,
+        from: &Coordinate,
+        to: &Coordinate,
+        buffer: Length,
+    ) -> Vec<(&Obstacle, Length)> {
+        let mut near: Vec<(u32, f32)> = Vec::new();
+
+        for part in Corridor::along(from, to, buffer) {
+            let cells =
+                CellId::covering(&part.bbox(), LEVEL).filter_map(|cell| self.cells.get(&cell));
+            for &i in cells.flatten() {
+                let coord = &self.obstacles[i as usize].coordinate;
+                let dist = part.dist(coord.latitude, coord.longitude);
+                if dist <= part.radius {
+                    near.push((i, dist));
+                }
+            }
+        }
+
+        // an obstacle might be near two parts of a long line
+        near.sort_unstable_by(|a, b| a.0.cmp(&b.0).then(a.1.total_cmp(&b.1)));
+        near.dedup_by_key(|(i, _)| *i);
+
+        near.into_iter()
+            .map(|(i, dist)| (&self.obstacles[i as usize], Length::nm(dist)))
+            .collect()
+    }
+}
+
+impl Obstacles {
+    /// Returns up to `limit` of the highest obstacles near the line compared
+    /// against the `level`.
+    pub(crate) fn highest(
+        &self,
+        from: &Coordinate,
+        to: &Coordinate,
+        buffer: Length,
+        level: Option<&VerticalDistance>,
+        limit: usize,
+    ) -> Vec<ObstacleClearance<'_>> {
+        let mut near = self.near(from, to, buffer);
+        let top = |obstacle: &Obstacle| msl_ft(&obstacle.elevation).unwrap_or_default();
+        near.sort_unstable_by(|a, b| top(b.0).total_cmp(&top(a.0)));
+        near.truncate(limit);
+
+        near.into_iter()
+            .map(|(obstacle, dist)| ObstacleClearance::new(obstacle, dist, level))
+            .collect()
+    }
+}
+
+impl Extend<Obstacle> for Obstacles {
+    fn extend<I: IntoIterator<Item = Obstacle>>(&mut self, iter: I) {
+        for obstacle in iter {
+            self.push(obstacle);
+        }
+    }
+}
+
+impl FromIterator<Obstacle> for Obstacles {
+    fn from_iter<I: IntoIterator<Item = Obstacle>>(iter: I) -> Self {
+        let mut obstacles = Self::new();
+        obstacles.extend(iter);
+        obstacles
+    }
+}
+
+/// Returns the altitude in feet of the `level` if it's referenced to mean sea
+/// level.
+fn msl_ft(level: &VerticalDistance) -> Option<f32> {
+    match *level {
+        VerticalDistance::Msl(ft) | VerticalDistance::Altitude(ft) => Some(ft as f32),
+        VerticalDistance::Fl(fl) => Some(fl as f32 * 100.0),
+        VerticalDistance::Gnd => Some(0.0),
+        _ => None,
+    }
+}
+
+impl<'a> ObstacleClearance<'a> {
+    fn new(obstacle: &'a Obstacle, dist: Length, level: Option<&VerticalDistance>) -> Self {
+        let clearance = level
+            .and_then(msl_ft)
+            .zip(msl_ft(&obstacle.elevation))
+            .map(|(level, top)| Length::ft(level - top));
+
+        Self {
+            obstacle,
+            dist: dist.convert_to(LengthUnit::NauticalMiles),
+            clearance,
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const OBSTACLES: &str = r#"# ident,latitude,longitude,elevation,height,lighted
+1,53.50,9.50,873,820,Y
+2,53.45,9.80,400,380,N
+
+3,53.90,9.50,1200,1150,Y
+"#;
+
+    #[test]
+    fn reads_obstacles() {
+        let mut obstacles = Obstacles::new();
+        obstacles
+            .read(OBSTACLES.as_bytes())
+            .expect("obstacles should be valid");
+
+        assert_eq!(obstacles.len(), 3);
+        assert_eq!(
+            obstacles.iter().next(),
+            Some(&Obstacle {
+                ident: String::from("1"),
+                coordinate: coord!(53.5, 9.5),
+                elevation: VerticalDistance::Msl(873),
+                height: VerticalDistance::Agl(820),
+                lighted: true,
+            })
+        );
+
+        let err = obstacles
+            .read("4,53.0,nine,100,90,N".as_bytes())
+            .expect_err("line should be malformed");
+        assert_eq!(err.kind(), io::ErrorKind::InvalidData);
+    }
+
+    #[test]
+    fn obstacles_near_line() {
+        let obstacles = Obstacles::from_iter(
+            OBSTACLES
+                .lines()
+                .filter_map(|line| line.parse::<Obstacle>().ok()),
+        );
+
+        let near = obstacles.near(&coord!(53.5, 9.0), &coord!(53.5, 10.0), Length::nm(5.0));
+        let idents: Vec<&str> = near.iter().map(|(o, _)| o.ident.as_str()).collect();
+        assert_eq!(idents, vec!["1", "2"]);
+        assert_eq!(near[1].1.value().round(), 3.0);
+    }
+
+    #[test]
+    fn highest_obstacles_below_level() {
+        let obstacles = Obstacles::from_iter(
+            OBSTACLES
+                .lines()
+                .filter_map(|line| line.parse::<Obstacle>().ok()),
+        );
+        let (from, to) = (coord!(53.5, 9.0), coord!(53.5, 10.0));
+        let level = VerticalDistance::Msl(1000);
+
+        let highest = obstacles.highest(&from, &to, Length::nm(30.0), Some(&level), 2);
+        let idents: Vec<&str> = highest.iter().map(|c| c.obstacle.ident.as_str()).collect();
+        assert_eq!(idents, vec!["3", "1"]);
+        assert_eq!(highest[0].clearance, Some(Length::ft(-200.0)));
+        assert_eq!(highest[1].clearance, Some(Length::ft(127.0)));
+
+        let highest = obstacles.highest(&from, &to, Length::nm(30.0), None, 1);
+        assert_eq!(highest[0].clearance, None);
+    }
+}
@@ -13,12 +13,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+use std::str::FromStr;
+
 use crate::error::Error;
 use crate::fc;
 use crate::geom::Coordinate;
 use crate::measurements::{Angle, Length};
+use crate::nd::delta::{record_hash, runway_hash};
+use crate::nd::records::Materialize;
 use crate::nd::*;
-use crate::{MagneticVariation, VerticalDistance};
+use crate::{DeclinationGrid, MagneticVariation, VerticalDistance};
 
 use arinc424;
 
@@ -36,10 +40,10 @@ impl<const I: usize> TryFrom<arinc424::IcaoCode<I>> for LocationIndicator {
     }
 }
 
-impl<const I: usize, const J: usize> From<(arinc424::Latitude<I>, arinc424::Longitude<J>)>
+impl<const I: usize, const J: usize> From<(&arinc424::Latitude<I>, &arinc424::Longitude<J>)>
     for Coordinate
 {
-    fn from(value: (arinc424::Latitude<I>, arinc424::Longitude<J>)) -> Self {
+    fn from(value: (&arinc424::Latitude<I>, &arinc424::Longitude<J>)) -> Self {
         let lat = fc::dms_to_decimal(value.0.degree, value.0.minutes, value.0.seconds);
         let long = fc::dms_to_decimal(value.1.degree, value.1.minutes, value.1.seconds);
 
@@ -65,10 +69,10 @@ impl<const I: usize, const J: usize, const K: usize> From<arinc424::MagVar<I, J,
         match value {
             arinc424::MagVar::East(d, cd) => Self::East(d as f32 + cd as f32 / 100.0),
             arinc424::MagVar::West(d, cd) => Self::West(d as f32 + cd as f32 / 100.0),
-            arinc424::MagVar::OrientedToTrueNorth => Self::OrientedToTrueNorth,
-            arinc424::MagVar::WMM(lat, long) => {
-                let coord: Coordinate = (lat, long).into();
-                Self::from(coord)
+            // without a grid at the epoch of the data, the declination isn't
+            // evaluated at all rather than at an arbitrary date
+            arinc424::MagVar::OrientedToTrueNorth | arinc424::MagVar::WMM(..) => {
+                Self::OrientedToTrueNorth
             }
         }
     }
@@ -113,25 +117,45 @@ impl From<arinc424::Runway> for Runway {
     }
 }
 
-impl From<arinc424::Airport> for Airport {
-    fn from(aprt: arinc424::Airport) -> Airport {
+/// Returns the stated magnetic variation or the declination of the `grid`,
+/// which is at the epoch of the loaded data. A record without a stated
+/// variation is oriented to true north if the model doesn't cover the epoch.
+fn mag_var<const I: usize, const J: usize, const K: usize>(
+    mag_var: arinc424::MagVar<I, J, K>,
+    grid: &DeclinationGrid,
+) -> MagneticVariation {
+    if let arinc424::MagVar::WMM(lat, long) = &mag_var {
+        if let Ok(declination) = grid.declination(&(lat, long).into()) {
+            return declination;
+        }
+    }
+
+    mag_var.into()
+}
+
+impl Airport {
+    fn from_record(aprt: arinc424::Airport, grid: &DeclinationGrid) -> Airport {
+        let cycle = aprt.cycle.into();
+
         Airport {
             icao_ident: aprt.arpt_ident.to_string(),
             iata_designator: aprt.iata.to_string(),
-            name: String::from(""),
-            coordinate: (aprt.latitude, aprt.longitude).into(),
-            mag_var: aprt.mag_var.into(),
+            name: aprt.arpt_name.to_string(),
+            coordinate: (&aprt.latitude, &aprt.longitude).into(),
+            mag_var: mag_var(aprt.mag_var, grid),
             // TODO: Parse elevation and runways.
             elevation: VerticalDistance::Gnd,
             runways: Vec::new(),
             location: aprt.icao_code.try_into().ok(),
-            cycle: Some(aprt.cycle.into()),
+            cycle: Some(cycle),
         }
     }
 }
 
-impl From<arinc424::Waypoint> for Waypoint {
-    fn from(wp: arinc424::Waypoint) -> Waypoint {
+impl Waypoint {
+    fn from_record(wp: arinc424::Waypoint, grid: &DeclinationGrid) -> Waypoint {
+        let cycle = wp.cycle.into();
+
         Waypoint {
             fix_ident: wp.fix_ident.to_string(),
             desc: wp.name_desc.to_string(),
@@ -141,11 +165,140 @@ impl From<arinc424::Waypoint> for Waypoint {
             } else {
                 WaypointUsage::Unknown
             },
-            coordinate: (wp.latitude, wp.longitude).into(),
+            coordinate: (&wp.latitude, &wp.longitude).into(),
             region: wp.regn_code.into(),
-            mag_var: wp.mag_var.into(),
+            mag_var: mag_var(wp.mag_var, grid),
             location: wp.icao_code.try_into().ok(),
-            cycle: Some(wp.cycle.into()),
+            cycle: Some(cycle),
         }
     }
 }
+
+// Records are materialized from lines that were already parsed successfully
+// while loading, thus, parsing them again is expected to succeed.
+
+impl Materialize for Airport {
+    type Key = (String, Option<LocationIndicator>);
+
+    fn materialize<'a>(
+        line: &'a str,
+        related: impl Iterator<Item = &'a str>,
+        grid: &DeclinationGrid,
+    ) -> Self {
+        let mut aprt = arinc424::Airport::from_str(line)
+            .map(|aprt| Airport::from_record(aprt, grid))
+            .expect("airport record should be valid");
+        aprt.runways = related
+            .filter_map(|line| arinc424::Runway::from_str(line).ok())
+            .map(Runway::from)
+            .collect();
+        aprt
+    }
+
+    fn raw_ident(line: &str) -> String {
+        arinc424::Airport::from_str(line)
+            .map(|aprt| aprt.arpt_ident.to_string())
+            .unwrap_or_default()
+    }
+
+    fn raw_name(line: &str) -> String {
+        arinc424::Airport::from_str(line)
+            .map(|aprt| aprt.arpt_name.to_string())
+            .unwrap_or_default()
+    }
+
+    fn raw_key(line: &str) -> Self::Key {
+        let aprt = arinc424::Airport::from_str(line).expect("airport record should be valid");
+        (aprt.arpt_ident.to_string(), aprt.icao_code.try_into().ok())
+    }
+
+    fn raw_states_mag_var(line: &str) -> bool {
+        arinc424::Airport::from_str(line)
+            .is_ok_and(|aprt| !matches!(aprt.mag_var, arinc424::MagVar::WMM(..)))
+    }
+
+    fn raw_hash<'a>(line: &'a str, related: impl Iterator<Item = &'a str>) -> u64 {
+        related
+            .filter_map(|line| arinc424::Runway::from_str(line).ok())
+            .map(Runway::from)
+            .fold(record_hash(line), |hash, rwy| {
+                hash.wrapping_add(runway_hash(&rwy))
+            })
+    }
+
+    fn name(&self) -> &str {
+        &self.name
+    }
+
+    fn key(&self) -> Self::Key {
+        (self.icao_ident.clone(), self.location)
+    }
+
+    fn location(key: &Self::Key) -> Option<LocationIndicator> {
+        key.1
+    }
+
+    fn cycle(&self) -> Option<AiracCycle> {
+        self.cycle
+    }
+}
+
+impl Materialize for Waypoint {
+    type Key = (String, Region, Option<LocationIndicator>);
+
+    fn materialize<'a>(
+        line: &'a str,
+        _related: impl Iterator<Item = &'a str>,
+        grid: &DeclinationGrid,
+    ) -> Self {
+        arinc424::Waypoint::from_str(line)
+            .map(|wp| Waypoint::from_record(wp, grid))
+            .expect("waypoint record should be valid")
+    }
+
+    fn raw_ident(line: &str) -> String {
+        arinc424::Waypoint::from_str(line)
+            .map(|wp| Region::from(wp.regn_code).prefix() + wp.fix_ident.as_str())
+            .unwrap_or_default()
+    }
+
+    fn raw_name(line: &str) -> String {
+        arinc424::Waypoint::from_str(line)
+            .map(|wp| wp.name_desc.to_string())
+            .unwrap_or_default()
+    }
+
+    fn raw_key(line: &str) -> Self::Key {
+        let wp = arinc424::Waypoint::from_str(line).expect("waypoint record should be valid");
+        (
+            wp.fix_ident.to_string(),
+            wp.regn_code.into(),
+            wp.icao_code.try_into().ok(),
+        )
+    }
+
+    fn raw_states_mag_var(line: &str) -> bool {
+        arinc424::Waypoint::from_str(line)
+            .is_ok_and(|wp| !matches!(wp.mag_var, arinc424::MagVar::WMM(..)))
+    }
+
+    fn raw_hash<'a>(line: &'a str, _related: impl Iterator<Item = &'a str>) -> u64 {
+        record_hash(line)
+    }
+
+    fn name(&self) -> &str {
+        &self.desc
+    }
+
+    fn key(&self) -> Self::Key {
+        (self.fix_ident.clone(), self.region, self.location)
+    }
+
+    fn location(key: &Self::Key) -> Option<LocationIndicator> {
+        key.2
+    }
+
+    fn cycle(&self) -> Option<AiracCycle> {
+        self.cycle
+    }
+}
@@ -13,29 +13,71 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-use std::collections::HashSet;
+use std::collections::{BTreeMap, HashMap, HashSet};
 use std::rc::Rc;
 use std::str::FromStr;
 
+use chrono::NaiveDate;
+
 use crate::error::Error;
+use crate::geom::Coordinate;
+use crate::nd::records::{Materialize, Records};
 use crate::nd::*;
 
 mod from;
 
 pub struct Arinc424Record {
-    pub(crate) airports: Vec<Rc<Airport>>,
-    pub(crate) waypoints: Vec<Rc<Waypoint>>,
+    pub(crate) airports: Records<Airport>,
+    pub(crate) waypoints: Records<Waypoint>,
+    pub(crate) airways: Airways,
+    pub(crate) procedures: Procedures,
     pub(crate) locations: Vec<LocationIndicator>,
     pub(crate) cycle: Option<AiracCycle>,
+    pub(crate) epoch: Option<NaiveDate>,
 }
 
 impl FromStr for Arinc424Record {
     type Err = Error;
 
     fn from_str(s: &str) -> Result<Self, Self::Err> {
-        let mut airports: Vec<Airport> = Vec::new();
-        let mut rwy_record_lines: Vec<&str> = Vec::new();
-        let mut waypoints: Vec<Rc<Waypoint>> = Vec::new();
+        Self::parse(s, &Filter::default(), None)
+    }
+}
+
+impl Arinc424Record {
+    /// Parses the records that pass the `filter`. The declination of records
+    /// without a stated magnetic variation is evaluated at the `epoch` or at
+    /// the effective date of the newest cycle of the records.
+    ///
+    /// Airways and procedures are built only from the waypoints that passed
+    /// the filter and runways and procedures of filtered airports are skipped.
+    pub fn parse(s: &str, filter: &Filter, epoch: Option<NaiveDate>) -> Result<Self, Error> {
+        Self::parse_records(s, None, filter, epoch)
+    }
+
+    /// Parses the records that pass the `filter` but builds the airports and
+    /// waypoints on first access from the `source`.
+    pub fn parse_lazy(
+        source: Rc<str>,
+        filter: &Filter,
+        epoch: Option<NaiveDate>,
+    ) -> Result<Self, Error> {
+        let s = Rc::clone(&source);
+        Self::parse_records(&s, Some(source), filter, epoch)
+    }
+
+    fn parse_records(
+        s: &str,
+        source: Option<Rc<str>>,
+        filter: &Filter,
+        epoch: Option<NaiveDate>,
+    ) -> Result<Self, Error> {
+        let mut aprt_record_lines: Vec<(&str, Coordinate)> = Vec::new();
+        let mut rwy_record_lines: HashMap<&str, Vec<&str>> = HashMap::new();
+        let mut wp_record_lines: Vec<(&str, Coordinate)> = Vec::new();
+        let mut awy_record_lines: Vec<&str> = Vec::new();
+        let mut proc_record_lines: Vec<&str> = Vec::new();
+        let mut fixes: FixLookup = HashMap::new();
         let mut locations: HashSet<LocationIndicator> = HashSet::new();
         let mut cycle: Option<AiracCycle> = None;
 
@@ -43,52 +85,257 @@ impl FromStr for Arinc424Record {
         s.lines().for_each(|line| match &line[4..6] {
             "EA" | "PC" => {
                 if let Ok(waypoint_record) = arinc424::Waypoint::from_str(line) {
-                    let wp = Waypoint::from(waypoint_record);
-                    if let Some(l) = wp.location {
-                        locations.insert(l);
+                    let coordinate = (&waypoint_record.latitude, &waypoint_record.longitude).into();
+                    let location = LocationIndicator::new(waypoint_record.icao_code.as_str()).ok();
+                    if !filter.includes(&coordinate, location) {
+                        return;
                     }
-                    if let Some(c) = wp.cycle {
-                        cycle = Some(cycle.map_or(c, |cycle| cycle.min(c)));
+
+                    if let Some(l) = location {
+                        locations.insert(l);
                     }
-                    waypoints.push(Rc::new(wp));
+                    cycle = cycle.max(Some(waypoint_record.cycle.into()));
+
+                    let region = Region::from(waypoint_record.regn_code);
+                    fixes.insert(
+                        (region, line[13..18].trim_end(), location),
+                        wp_record_lines.len() as u32,
+                    );
+                    wp_record_lines.push((line, coordinate));
                 }
             }
+            "ER" => awy_record_lines.push(line),
             "P " => match &line[12..13] {
                 "A" => {
                     if let Ok(airport_record) = arinc424::Airport::from_str(line) {
-                        let aprt = Airport::from(airport_record);
-                        if let Some(l) = aprt.location {
-                            locations.insert(l);
+                        let coordinate =
+                            (&airport_record.latitude, &airport_record.longitude).into();
+                        let location =
+                            LocationIndicator::new(airport_record.icao_code.as_str()).ok();
+                        if !filter.includes(&coordinate, location) {
+                            return;
                         }
-                        if let Some(c) = aprt.cycle {
-                            cycle = Some(cycle.map_or(c, |cycle| cycle.min(c)));
+
+                        if let Some(l) = location {
+                            locations.insert(l);
                         }
-                        airports.push(aprt);
+                        cycle = cycle.max(Some(airport_record.cycle.into()));
+
+                        aprt_record_lines.push((line, coordinate));
                     }
                 }
-                "G" => rwy_record_lines.push(line),
+                "G" => rwy_record_lines
+                    .entry(line[6..10].trim_end())
+                    .or_default()
+                    .push(line),
+                "D" | "E" | "F" => proc_record_lines.push(line),
                 _ => {}
             },
             _ => {}
         });
 
-        // now that we know all airports, we can assign the runways
-        rwy_record_lines.iter().for_each(|line| {
-            if let Ok(rwy_record) = arinc424::Runway::from_str(line) {
-                if let Some(aprt) = airports
-                    .iter_mut()
-                    .find(|aprt| rwy_record.arpt_ident == aprt.icao_ident.as_str())
-                {
-                    aprt.runways.push(rwy_record.into());
-                }
+        // the declination is evaluated at one date for all records, thus,
+        // it's the same regardless of when the data is loaded
+        let epoch = epoch.or_else(|| crate::nd::epoch(cycle));
+        let grid = declination_grid(epoch);
+
+        let (mut airports, mut waypoints) = match &source {
+            Some(source) => (
+                Records::lazy(Rc::clone(source), Rc::clone(&grid)),
+                Records::lazy(Rc::clone(source), Rc::clone(&grid)),
+            ),
+            None => (Records::default(), Records::default()),
+        };
+
+        // lazy records are located by the offset of their line in the source
+        let offset = |line: &str| line.as_ptr() as usize - s.as_ptr() as usize;
+        let lazy = source.is_some();
+
+        for (line, coordinate) in &aprt_record_lines {
+            let runways = rwy_record_lines
+                .get(line[6..10].trim_end())
+                .map(Vec::as_slice)
+                .unwrap_or_default();
+
+            if lazy {
+                airports.push_raw(offset(line), runways.iter().map(|l| offset(l)), *coordinate);
+            } else {
+                airports.push(
+                    Airport::materialize(line, runways.iter().copied(), &grid),
+                    Airport::raw_hash(line, runways.iter().copied()),
+                );
             }
-        });
+        }
+
+        for (line, coordinate) in &wp_record_lines {
+            if lazy {
+                waypoints.push_raw(offset(line), [], *coordinate);
+            } else {
+                waypoints.push(
+                    Waypoint::materialize(line, std::iter::empty(), &grid),
+                    Waypoint::raw_hash(line, std::iter::empty()),
+                );
+            }
+        }
+
+        let airport_lookup: HashMap<&str, u32> = aprt_record_lines
+            .iter()
+            .enumerate()
+            .map(|(i, (line, _))| (line[6..10].trim_end(), i as u32))
+            .collect();
+
+        let airways = airways_from_records(&awy_record_lines, &fixes, waypoints.len());
+        let procedures = procedures_from_records(&proc_record_lines, &fixes, &airport_lookup);
 
         Ok(Self {
-            airports: airports.into_iter().map(Rc::new).collect(),
+            airports,
             waypoints,
+            airways,
+            procedures,
             locations: locations.into_iter().collect(),
             cycle,
+            epoch,
         })
     }
 }
+
+/// Lookup of waypoint indices by their region, fix ident and location.
+type FixLookup<'a> = HashMap<(Region, &'a str, Option<LocationIndicator>), u32>;
+
+/// Creates the airway network from the airway records.
+///
+/// The records are grouped into airways by their route ident and customer
+/// area, since airways of different areas might share an ident. The fixes of
+/// an airway are resolved to the index of the enroute waypoint with the same
+/// ident and location. Fixes that are not within the waypoints, e.g. VHF
+/// navaids, are skipped and the airway continues with the next fix.
+fn airways_from_records(lines: &[&str], fixes: &FixLookup, fix_count: usize) -> Airways {
+    type Fixes = (Option<AiracCycle>, Vec<(u32, u32)>);
+    let mut airways: HashMap<(String, &str), Fixes> = HashMap::new();
+
+    lines.iter().for_each(|line| {
+        if let Ok(awy_record) = arinc424::Airway::from_str(line) {
+            if awy_record.fix_sec_sub_code != "EA" {
+                return;
+            }
+
+            let key = (
+                Region::Enroute,
+                awy_record.fix_ident.as_str(),
+                awy_record.icao_code.try_into().ok(),
+            );
+
+            if let Some(&fix) = fixes.get(&key) {
+                let (cycle, fixes) = airways
+                    .entry((awy_record.route_ident.to_string(), &line[1..4]))
+                    .or_default();
+                *cycle = (*cycle).max(Some(awy_record.cycle.into()));
+                fixes.push((awy_record.seq_nr.into(), fix));
+            }
+        }
+    });
+
+    let mut airways: Vec<((String, &str), Fixes)> = airways.into_iter().collect();
+    airways.sort_by(|a, b| a.0.cmp(&b.0));
+
+    Airways::new(
+        airways
+            .into_iter()
+            .map(|((ident, area), (cycle, mut fixes))| {
+                fixes.sort_by_key(|(seq, _)| *seq);
+                Airway {
+                    ident,
+                    area: area.to_string(),
+                    cycle,
+                    fixes,
+                }
+            }),
+        fix_count,
+    )
+}
+
+/// Creates the terminal procedures from the SID, STAR and approach records.
+///
+/// The legs are grouped by procedure and transition and their fixes are
+/// resolved to the index of the terminal or enroute waypoint. Legs that don't
+/// terminate at a waypoint, e.g. a climb to an altitude, are skipped.
+fn procedures_from_records(
+    lines: &[&str],
+    fixes: &FixLookup,
+    airport_lookup: &HashMap<&str, u32>,
+) -> Procedures {
+    type Transitions = BTreeMap<(String, TransitionKind), Vec<(u32, Option<u32>)>>;
+    let mut procedures: BTreeMap<(u32, String, ProcedureKind), Transitions> = BTreeMap::new();
+
+    lines.iter().for_each(|line| {
+        let Ok(proc_record) = arinc424::Procedure::from_str(line) else {
+            return;
+        };
+
+        let Some(&airport) = airport_lookup.get(proc_record.arpt_ident.as_str()) else {
+            return;
+        };
+
+        let kind = match proc_record.sub_code {
+            arinc424::SubCode::SID => ProcedureKind::Departure,
+            arinc424::SubCode::STAR => ProcedureKind::Arrival,
+            _ => ProcedureKind::Approach,
+        };
+
+        let transition_kind = match (kind, proc_record.route_type.as_str()) {
+            // engine out SIDs are not flown as part of a route
+            (ProcedureKind::Departure, "0") => return,
+            (ProcedureKind::Departure, "1" | "4" | "F") => TransitionKind::Runway,
+            (ProcedureKind::Departure, "3" | "6" | "S" | "V") => TransitionKind::Enroute,
+            (ProcedureKind::Arrival, "1" | "4" | "7") => TransitionKind::Enroute,
+            (ProcedureKind::Arrival, "3" | "6" | "9") => TransitionKind::Runway,
+            (ProcedureKind::Approach, "A") => TransitionKind::Enroute,
+            // missed approaches are not flown as part of a route
+            (ProcedureKind::Approach, "Z") => return,
+            _ => TransitionKind::Common,
+        };
+
+        let region = match proc_record.fix_sec_sub_code.as_str() {
+            "EA" => Some(Region::Enroute),
+            "PC" => Some(Region::TerminalArea(proc_record.arpt_ident.into_inner())),
+            _ => None,
+        };
+
+        let fix = region.and_then(|region| {
+            fixes
+                .get(&(
+                    region,
+                    proc_record.fix_ident.as_str(),
+                    proc_record.fix_icao_code.try_into().ok(),
+                ))
+                .copied()
+        });
+
+        procedures
+            .entry((airport, proc_record.proc_ident.to_string(), kind))
+            .or_default()
+            .entry((proc_record.trans_ident.to_string(), transition_kind))
+            .or_default()
+            .push((proc_record.seq_nr.into(), fix));
+    });
+
+    let mut result = Procedures::default();
+
+    for ((airport, ident, kind), transitions) in procedures {
+        result.push(
+            ident,
+            kind,
+            airport,
+            transitions.into_iter().map(|((ident, kind), mut legs)| {
+                legs.sort_by_key(|(seq, _)| *seq);
+                (
+                    ident,
+                    kind,
+                    legs.into_iter().filter_map(|(_, fix)| fix).collect(),
+                )
+            }),
+        );
+    }
+
+    result
+}
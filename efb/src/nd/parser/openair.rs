@@ -26,7 +26,7 @@ use std::str::FromStr;
 use crate::error::Error;
 use crate::fc;
 use crate::geom::{Coordinate, Polygon};
-use crate::nd::{Airspace, AirspaceClass};
+use crate::nd::{Airspace, AirspaceClass, Filter};
 use crate::VerticalDistance;
 
 /// An element representing an airspace.
@@ -242,25 +242,37 @@ impl OpenAirRecord {
     }
 }
 
-impl FromStr for OpenAirRecord {
-    type Err = Error;
-
-    fn from_str(s: &str) -> Result<Self, Self::Err> {
+impl OpenAirRecord {
+    /// Parses the airspaces that pass the `filter`.
+    pub fn parse(s: &str, filter: &Filter) -> Result<Self, Error> {
         let mut airspaces = Vec::new();
         let mut element = OpenAirElement::new();
 
         s.lines().for_each(|command| {
             if let Some(airspace) = Self::parse_command(command, &mut element) {
-                airspaces.push(airspace);
+                if filter.includes_airspace(&airspace) {
+                    airspaces.push(airspace);
+                }
             }
         });
 
-        airspaces.push((&mut element).into());
+        let airspace: Airspace = (&mut element).into();
+        if filter.includes_airspace(&airspace) {
+            airspaces.push(airspace);
+        }
 
         Ok(Self { airspaces })
     }
 }
 
+impl FromStr for OpenAirRecord {
+    type Err = Error;
+
+    fn from_str(s: &str) -> Result<Self, Self::Err> {
+        Self::parse(s, &Filter::default())
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
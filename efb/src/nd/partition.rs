@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::collections::HashMap;
+
+use super::records::{Materialize, Records};
+use super::{Airport, LocationIndicator, Waypoint};
+
+/// The indices of records partitioned by their location.
+///
+/// The indices of each location are sorted, thus, all records of a location
+/// are a slice and whether a record is within a location is found by a
+/// binary search.
+#[derive(Clone, Debug, Default)]
+pub(crate) struct Partition(HashMap<Option<LocationIndicator>, Vec<u32>>);
+
+impl Partition {
+    pub(crate) fn new<T: Materialize>(records: &Records<T>) -> Self {
+        let mut partition = Self::default();
+        for (i, key) in records.keys() {
+            partition
+                .0
+                .entry(T::location(&key))
+                .or_default()
+                .push(i as u32);
+        }
+
+        partition
+    }
+
+    /// Returns the indices of the records at the `location`.
+    pub(crate) fn get(&self, location: Option<LocationIndicator>) -> &[u32] {
+        self.0.get(&location).map(Vec::as_slice).unwrap_or_default()
+    }
+
+    /// Returns `true` if the record at the `index` is at the `location`.
+    pub(crate) fn contains(&self, location: Option<LocationIndicator>, index: u32) -> bool {
+        self.get(location).binary_search(&index).is_ok()
+    }
+
+    pub(crate) fn insert(&mut self, location: Option<LocationIndicator>, index: u32) {
+        let indices = self.0.entry(location).or_default();
+        if let Err(i) = indices.binary_search(&index) {
+            indices.insert(i, index);
+        }
+    }
+
+    /// Maps the indices by `remap` and drops those that are mapped to `None`.
+    /// The mapping must keep the order of the indices.
+    pub(crate) fn remap(&mut self, remap: &[Option<u32>]) {
+        for indices in self.0.values_mut() {
+            indices.retain_mut(|i| match remap[*i as usize] {
+                Some(index) => {
+                    *i = index;
+                    true
+                }
+                None => false,
+            });
+        }
+    }
+
+    pub(crate) fn remove(&mut self, location: Option<LocationIndicator>, index: u32) {
+        if let Some(indices) = self.0.get_mut(&location) {
+            if let Ok(i) = indices.binary_search(&index) {
+                indices.remove(i);
+            }
+        }
+    }
+}
+
+/// The airports and waypoints partitioned by their location.
+#[derive(Clone, Debug, Default)]
+pub(crate) struct Partitions {
+    pub(crate) airports: Partition,
+    pub(crate) waypoints: Partition,
+}
+
+impl Partitions {
+    pub(crate) fn new(airports: &Records<Airport>, waypoints: &Records<Waypoint>) -> Self {
+        Self {
+            airports: Partition::new(airports),
+            waypoints: Partition::new(waypoints),
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn keeps_indices_sorted() {
+        let ed = LocationIndicator::new("ED").ok();
+        let mut partition = Partition::default();
+        for i in [4, 1, 3] {
+            partition.insert(ed, i);
+        }
+        partition.remove(ed, 3);
+
+        assert_eq!(partition.get(ed), &[1, 4]);
+        assert!(partition.contains(ed, 4));
+        assert!(!partition.contains(LocationIndicator::new("EH").ok(), 4));
+    }
+}
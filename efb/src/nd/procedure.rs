@@ -0,0 +1,451 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::collections::HashMap;
+use std::ops::Range;
+
+#[cfg(feature = "serde")]
+use serde::{Deserialize, Serialize};
+
+use super::merge::Resolution;
+
+/// The kind of a terminal procedure.
+#[derive(Copy, Clone, Eq, PartialEq, Ord, PartialOrd, Hash, Debug)]
+#[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
+pub enum ProcedureKind {
+    /// Standard instrument departure (SID).
+    Departure,
+    /// Standard terminal arrival route (STAR).
+    Arrival,
+    /// Instrument approach procedure.
+    Approach,
+}
+
+/// The part of a procedure that a transition covers.
+#[derive(Copy, Clone, Eq, PartialEq, Ord, PartialOrd, Hash, Debug)]
+#[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
+pub enum TransitionKind {
+    /// The transition from or to a runway.
+    Runway,
+    /// The route that is common to all transitions. For approaches, this is the
+    /// final approach.
+    Common,
+    /// The transition from or to the enroute structure. For approaches, this is
+    /// the approach transition.
+    Enroute,
+}
+
+/// A terminal procedure of an airport.
+#[derive(Clone, PartialEq, Debug)]
+#[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
+pub struct Procedure {
+    ident: String,
+    kind: ProcedureKind,
+    airport: u32,
+    transitions: Range<u32>,
+}
+
+impl Procedure {
+    /// The procedure identifier, e.g. `NOVE1A`.
+    pub fn ident(&self) -> &str {
+        &self.ident
+    }
+
+    /// The kind of procedure.
+    pub fn kind(&self) -> ProcedureKind {
+        self.kind
+    }
+
+    /// The index of the airport to which the procedure belongs.
+    pub fn airport(&self) -> usize {
+        self.airport as usize
+    }
+}
+
+/// A transition of a procedure.
+#[derive(Clone, PartialEq, Debug)]
+#[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
+pub struct Transition {
+    ident: String,
+    kind: TransitionKind,
+    fixes: Range<u32>,
+}
+
+impl Transition {
+    /// The transition identifier, e.g. `RW33` for a runway transition or the
+    /// ident of the fix where an enroute transition starts or ends.
+    pub fn ident(&self) -> &str {
+        &self.ident
+    }
+
+    /// The part of the procedure that the transition covers.
+    pub fn kind(&self) -> TransitionKind {
+        self.kind
+    }
+
+    /// Returns `true` if this runway transition serves the runway with the
+    /// `designator`.
+    ///
+    /// Besides the transition to a single runway e.g. `RW33`, a transition
+    /// might serve all runways (`ALL`) or parallel runways e.g. `RW33B` for
+    /// `33L` and `33R`.
+    pub fn serves_runway(&self, designator: &str) -> bool {
+        match self.ident.strip_prefix("RW") {
+            Some(rwy) if rwy == designator => true,
+            Some(rwy) => rwy
+                .strip_suffix('B')
+                .is_some_and(|rwy| designator.strip_prefix(rwy).is_some_and(|s| s.len() == 1)),
+            None => self.ident == "ALL",
+        }
+    }
+}
+
+/// The terminal procedures with their transitions.
+///
+/// Like the [airways], procedures don't own their fixes but refer to them by
+/// the index into the waypoints of the navigation data. Each procedure spans a
+/// range of transitions and each transition a range of fix indices.
+///
+/// [airways]: super::Airways
+#[derive(Clone, PartialEq, Debug, Default)]
+#[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
+pub struct Procedures {
+    procedures: Vec<Procedure>,
+    transitions: Vec<Transition>,
+    fixes: Vec<u32>,
+    lookup: HashMap<String, Vec<u32>>,
+}
+
+impl Procedures {
+    /// Appends a procedure of the airport with index `airport`.
+    ///
+    /// The transitions are given as ident, kind and sequence of fix indices.
+    pub(crate) fn push<I>(
+        &mut self,
+        ident: String,
+        kind: ProcedureKind,
+        airport: u32,
+        transitions: I,
+    ) where
+        I: IntoIterator<Item = (String, TransitionKind, Vec<u32>)>,
+    {
+        let start = self.transitions.len() as u32;
+
+        for (ident, kind, fixes) in transitions {
+            let fixes_start = self.fixes.len() as u32;
+            self.fixes.extend(fixes);
+            self.transitions.push(Transition {
+                ident,
+                kind,
+                fixes: fixes_start..self.fixes.len() as u32,
+            });
+        }
+
+        self.lookup
+            .entry(ident.clone())
+            .or_default()
+            .push(self.procedures.len() as u32);
+
+        self.procedures.push(Procedure {
+            ident,
+            kind,
+            airport,
+            transitions: start..self.transitions.len() as u32,
+        });
+    }
+
+    /// Returns the number of procedures.
+    pub fn len(&self) -> usize {
+        self.procedures.len()
+    }
+
+    /// Returns `true` if there are no procedures.
+    pub fn is_empty(&self) -> bool {
+        self.procedures.is_empty()
+    }
+
+    /// Returns all procedures with the `ident` at any airport.
+    pub fn find(&self, ident: &str) -> impl Iterator<Item = &Procedure> {
+        self.lookup
+            .get(ident)
+            .into_iter()
+            .flatten()
+            .map(|&i| &self.procedures[i as usize])
+    }
+
+    /// Returns the transitions of the `procedure`.
+    pub fn transitions(&self, procedure: &Procedure) -> &[Transition] {
+        &self.transitions[procedure.transitions.start as usize..procedure.transitions.end as usize]
+    }
+
+    /// Returns the fix indices of the `transition` in sequence order.
+    pub fn fixes(&self, transition: &Transition) -> impl Iterator<Item = usize> + '_ {
+        self.fixes[transition.fixes.start as usize..transition.fixes.end as usize]
+            .iter()
+            .map(|&fix| fix as usize)
+    }
+
+    /// Returns the fix indices when flying the `procedure`.
+    ///
+    /// The runway transition of the runway with the `designator` and the
+    /// `transition` with the ident are joined with the common route in the
+    /// order they are flown. Returns `None` if the `transition` is not part of
+    /// the procedure.
+    pub fn expand(
+        &self,
+        procedure: &Procedure,
+        designator: Option<&str>,
+        transition: Option<&str>,
+    ) -> Option<Vec<usize>> {
+        let transitions = self.transitions(procedure);
+
+        let runway = designator.and_then(|designator| {
+            transitions
+                .iter()
+                .find(|t| t.kind == TransitionKind::Runway && t.serves_runway(designator))
+        });
+
+        let enroute = match transition {
+            Some(ident) => Some(
+                transitions
+                    .iter()
+                    .find(|t| t.kind == TransitionKind::Enroute && t.ident == ident)?,
+            ),
+            None => None,
+        };
+
+        let common = transitions
+            .iter()
+            .filter(|t| t.kind == TransitionKind::Common);
+
+        let sequence: Vec<&Transition> = match procedure.kind {
+            ProcedureKind::Departure => runway.into_iter().chain(common).chain(enroute).collect(),
+            ProcedureKind::Arrival => enroute.into_iter().chain(common).chain(runway).collect(),
+            ProcedureKind::Approach => enroute.into_iter().chain(common).collect(),
+        };
+
+        let mut fixes: Vec<usize> = Vec::new();
+        for fix in sequence.into_iter().flat_map(|t| self.fixes(t)) {
+            // transitions join the common route at the same fix
+            if fixes.last() != Some(&fix) {
+                fixes.push(fix);
+            }
+        }
+
+        Some(fixes)
+    }
+
+    /// Merges the `other` procedures into these procedures and returns the
+    /// airport index and ident of conflicting procedures.
+    ///
+    /// The airports and fixes of the other procedures are mapped by
+    /// `airport_remap` and `fix_remap`. A procedure of the same airport,
+    /// ident and kind is merged into the existing one according to the
+    /// `resolution` if both have different transitions.
+    pub(crate) fn merge(
+        &mut self,
+        other: Procedures,
+        airport_remap: impl Fn(u32) -> u32,
+        fix_remap: impl Fn(u32) -> u32,
+        resolution: Resolution,
+    ) -> Vec<(usize, String)> {
+        type Legs = Vec<(String, TransitionKind, Vec<u32>)>;
+
+        let legs = |procedures: &Procedures, procedure: &Procedure, remap: &dyn Fn(u32) -> u32| {
+            procedures
+                .transitions(procedure)
+                .iter()
+                .map(|t| {
+                    (
+                        t.ident.clone(),
+                        t.kind,
+                        procedures.fixes(t).map(|fix| remap(fix as u32)).collect(),
+                    )
+                })
+                .collect::<Legs>()
+        };
+
+        let mut merged: Vec<(String, ProcedureKind, u32, Legs)> = self
+            .procedures
+            .iter()
+            .map(|p| {
+                (
+                    p.ident.clone(),
+                    p.kind,
+                    p.airport,
+                    legs(self, p, &|fix| fix),
+                )
+            })
+            .collect();
+        let mut lookup: HashMap<(u32, String, ProcedureKind), usize> = merged
+            .iter()
+            .enumerate()
+            .map(|(i, (ident, kind, airport, _))| ((*airport, ident.clone(), *kind), i))
+            .collect();
+        let mut conflicts = Vec::new();
+
+        for procedure in &other.procedures {
+            let airport = airport_remap(procedure.airport);
+            let transitions = legs(&other, procedure, &fix_remap);
+            let key = (airport, procedure.ident.clone(), procedure.kind);
+
+            match lookup.get(&key) {
+                Some(&existing) if merged[existing].3 != transitions => match resolution {
+                    Resolution::Replace => merged[existing].3 = transitions,
+                    Resolution::Conflict => {
+                        conflicts.push((airport as usize, procedure.ident.clone()))
+                    }
+                    Resolution::Keep => {}
+                },
+                Some(_) => {}
+                None => {
+                    lookup.insert(key, merged.len());
+                    merged.push((
+                        procedure.ident.clone(),
+                        procedure.kind,
+                        airport,
+                        transitions,
+                    ));
+                }
+            }
+        }
+
+        *self = Self::default();
+        for (ident, kind, airport, transitions) in merged {
+            self.push(ident, kind, airport, transitions);
+        }
+
+        conflicts
+    }
+
+    /// Maps the airports and fixes of the procedures by `airport_remap` and
+    /// `fix_remap`.
+    ///
+    /// Procedures of airports that are mapped to `None` are dropped and
+    /// fixes that are mapped to `None` are skipped, like removed waypoints.
+    pub(crate) fn compact(
+        &mut self,
+        airport_remap: impl Fn(u32) -> Option<u32>,
+        fix_remap: impl Fn(u32) -> Option<u32>,
+    ) {
+        let procedures = std::mem::take(self);
+
+        for procedure in &procedures.procedures {
+            let Some(airport) = airport_remap(procedure.airport) else {
+                continue;
+            };
+
+            self.push(
+                procedure.ident.clone(),
+                procedure.kind,
+                airport,
+                procedures.transitions(procedure).iter().map(|t| {
+                    (
+                        t.ident.clone(),
+                        t.kind,
+                        procedures
+                            .fixes(t)
+                            .filter_map(|fix| fix_remap(fix as u32))
+                            .collect(),
+                    )
+                }),
+            );
+        }
+    }
+
+    /// Appends the `other` procedures whose airport and fix indices are
+    /// shifted by the `airport_offset` and `fix_offset`.
+    pub(crate) fn append(&mut self, other: Procedures, airport_offset: usize, fix_offset: usize) {
+        for procedure in &other.procedures {
+            self.push(
+                procedure.ident.clone(),
+                procedure.kind,
+                procedure.airport + airport_offset as u32,
+                other.transitions(procedure).iter().map(|t| {
+                    (
+                        t.ident.clone(),
+                        t.kind,
+                        other
+                            .fixes(t)
+                            .map(|fix| (fix + fix_offset) as u32)
+                            .collect(),
+                    )
+                }),
+            );
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn procedures() -> Procedures {
+        let mut procedures = Procedures::default();
+        procedures.push(
+            String::from("ABBE1D"),
+            ProcedureKind::Departure,
+            0,
+            vec![
+                (String::from("RW33"), TransitionKind::Runway, vec![0, 1]),
+                (String::from("RW05"), TransitionKind::Runway, vec![2, 1]),
+                (String::new(), TransitionKind::Common, vec![1, 3]),
+                (String::from("ABBEN"), TransitionKind::Enroute, vec![3, 4]),
+            ],
+        );
+        procedures
+    }
+
+    #[test]
+    fn expands_departure() {
+        let procedures = procedures();
+        let sid = procedures.find("ABBE1D").next().expect("SID should exist");
+
+        assert_eq!(
+            procedures.expand(sid, Some("33"), Some("ABBEN")),
+            Some(vec![0, 1, 3, 4])
+        );
+        assert_eq!(
+            procedures.expand(sid, Some("05"), None),
+            Some(vec![2, 1, 3])
+        );
+        assert_eq!(procedures.expand(sid, None, Some("XYZ")), None);
+    }
+
+    #[test]
+    fn serves_parallel_runways() {
+        let transition = Transition {
+            ident: String::from("RW33B"),
+            kind: TransitionKind::Runway,
+            fixes: 0..0,
+        };
+
+        assert!(transition.serves_runway("33L"));
+        assert!(transition.serves_runway("33R"));
+        assert!(!transition.serves_runway("15L"));
+    }
+
+    #[test]
+    fn compact_drops_procedures_of_removed_airports() {
+        let mut procedures = procedures();
+        procedures.compact(Some, |fix| (fix != 1).then_some(fix));
+        let sid = procedures.find("ABBE1D").next().expect("SID should exist");
+        assert_eq!(procedures.expand(sid, Some("33"), None), Some(vec![0, 3]));
+
+        procedures.compact(|_| None, Some);
+        assert!(procedures.is_empty());
+        assert!(procedures.find("ABBE1D").next().is_none());
+    }
+}
@@ -0,0 +1,763 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::cell::OnceCell;
+use std::collections::HashMap;
+use std::fmt::Debug;
+use std::hash::Hash;
+use std::ops::{Index, Range};
+use std::rc::Rc;
+
+#[cfg(feature = "serde")]
+use serde::{Deserialize, Deserializer, Serialize, Serializer};
+
+use crate::geom::Coordinate;
+use crate::DeclinationGrid;
+
+use super::merge::Resolution;
+use super::{AiracCycle, Fix, LocationIndicator};
+
+/// An item that can be materialized from its raw record line.
+pub(crate) trait Materialize: Fix + Sized {
+    /// The key that identifies the same item within different records.
+    type Key: Clone + Debug + Eq + Hash;
+
+    /// Builds the item from its record `line` and the `related` lines, e.g.
+    /// the runways of an airport. The declination of a record without a
+    /// stated magnetic variation is interpolated from the `grid`.
+    fn materialize<'a>(
+        line: &'a str,
+        related: impl Iterator<Item = &'a str>,
+        grid: &DeclinationGrid,
+    ) -> Self;
+
+    /// Returns the ident from the record `line` without building the item.
+    fn raw_ident(line: &str) -> String;
+
+    /// Returns the name from the record `line` without building the item.
+    fn raw_name(line: &str) -> String;
+
+    /// Returns the key from the record `line` without building the item.
+    fn raw_key(line: &str) -> Self::Key;
+
+    /// Returns whether the record `line` states the magnetic variation, thus,
+    /// the item is the same regardless of the grid it's built with.
+    fn raw_states_mag_var(line: &str) -> bool;
+
+    /// Returns the content hash of the record `line` and the `related` lines
+    /// without building the item. The hash is of the raw fields, thus, it
+    /// doesn't depend on the epoch at which the declination is evaluated.
+    fn raw_hash<'a>(line: &'a str, related: impl Iterator<Item = &'a str>) -> u64;
+
+    /// Returns the name of the item, e.g. an airport's name.
+    fn name(&self) -> &str;
+
+    /// Returns the key of the item.
+    fn key(&self) -> Self::Key;
+
+    /// Returns the location of the item with the `key`.
+    fn location(key: &Self::Key) -> Option<LocationIndicator>;
+
+    /// Returns the AIRAC cycle of the item.
+    fn cycle(&self) -> Option<AiracCycle>;
+}
+
+/// The text of lazy records with the grid from which the declination of
+/// records without a stated magnetic variation is interpolated.
+#[derive(Clone, Debug)]
+struct Source {
+    text: Rc<str>,
+    grid: Rc<DeclinationGrid>,
+}
+
+/// The location of a raw record within the sources.
+#[derive(Clone, Debug)]
+struct Raw {
+    source: u32,
+    offset: u32,
+    related: Range<u32>,
+}
+
+#[derive(Clone, Debug)]
+struct Entry<T> {
+    raw: Option<Raw>,
+    coordinate: Coordinate,
+    hash: u64,
+    item: OnceCell<Rc<T>>,
+}
+
+impl<T> Entry<T> {
+    /// A removed entry is neither built nor raw. It's kept so the indices of
+    /// the other entries stay valid.
+    fn is_removed(&self) -> bool {
+        self.raw.is_none() && self.item.get().is_none()
+    }
+}
+
+/// Records of navigation aids that are either built when loaded or lazily on
+/// first access.
+///
+/// A lazy record keeps only the offset of its line within the source and the
+/// coordinate. The item is built from the line when it's accessed for the
+/// first time and kept from then on. Thus, loading lazy records costs not
+/// much more than reading the source.
+///
+/// The index of each key and the content hash of all records are kept up to
+/// date by every change, so updating a few records doesn't touch the others.
+#[derive(Clone, Debug)]
+pub(crate) struct Records<T: Materialize> {
+    sources: Vec<Source>,
+    related: Vec<u32>,
+    entries: Vec<Entry<T>>,
+    lookup: HashMap<T::Key, u32>,
+    hash: u64,
+}
+
+impl<T: Materialize> Default for Records<T> {
+    fn default() -> Self {
+        Self {
+            sources: Vec::new(),
+            related: Vec::new(),
+            entries: Vec::new(),
+            lookup: HashMap::new(),
+            hash: 0,
+        }
+    }
+}
+
+impl<T: Materialize> Records<T> {
+    /// Creates lazy records whose lines are read from the `source`. Items are
+    /// built with the declination of the `grid`.
+    pub(crate) fn lazy(source: Rc<str>, grid: Rc<DeclinationGrid>) -> Self {
+        Self {
+            sources: vec![Source { text: source, grid }],
+            ..Self::default()
+        }
+    }
+
+    /// Appends a built item with its content `hash`.
+    pub(crate) fn push(&mut self, item: T, hash: u64) {
+        self.entries.push(Entry {
+            raw: None,
+            coordinate: item.coordinate(),
+            hash,
+            item: OnceCell::from(Rc::new(item)),
+        });
+        self.link(self.entries.len() - 1);
+    }
+
+    /// Appends a lazy record at the `offset` within the source with the
+    /// offsets of the `related` lines.
+    pub(crate) fn push_raw(
+        &mut self,
+        offset: usize,
+        related: impl IntoIterator<Item = usize>,
+        coordinate: Coordinate,
+    ) {
+        let start = self.related.len() as u32;
+        self.related
+            .extend(related.into_iter().map(|offset| offset as u32));
+
+        let raw = Raw {
+            source: self.sources.len() as u32 - 1,
+            offset: offset as u32,
+            related: start..self.related.len() as u32,
+        };
+        let hash = T::raw_hash(self.raw_line(&raw), self.raw_related(&raw));
+
+        self.entries.push(Entry {
+            raw: Some(raw),
+            coordinate,
+            hash,
+            item: OnceCell::new(),
+        });
+        self.link(self.entries.len() - 1);
+    }
+
+    /// Replaces the item at the `index` by a built item with its content
+    /// `hash`.
+    pub(crate) fn replace(&mut self, index: usize, item: T, hash: u64) {
+        self.unlink(index);
+        self.entries[index] = Entry {
+            raw: None,
+            coordinate: item.coordinate(),
+            hash,
+            item: OnceCell::from(Rc::new(item)),
+        };
+        self.link(index);
+    }
+
+    /// Removes the item at the `index` without shifting the following items.
+    pub(crate) fn remove(&mut self, index: usize) {
+        self.unlink(index);
+        let entry = &mut self.entries[index];
+        entry.raw = None;
+        entry.hash = 0;
+        entry.item.take();
+    }
+
+    /// Adds the key and hash of the entry at the `index` to the lookup and
+    /// the content hash.
+    fn link(&mut self, index: usize) {
+        let key = self.key(&self.entries[index]);
+        self.lookup.insert(key, index as u32);
+        self.hash = self.hash.wrapping_add(self.entries[index].hash);
+    }
+
+    /// Drops the key and hash of the entry at the `index` from the lookup and
+    /// the content hash.
+    fn unlink(&mut self, index: usize) {
+        let entry = &self.entries[index];
+        if entry.is_removed() {
+            return;
+        }
+
+        // appended records might hold the key more than once
+        let key = self.key(entry);
+        if self.lookup.get(&key) == Some(&(index as u32)) {
+            self.lookup.remove(&key);
+        }
+        self.hash = self.hash.wrapping_sub(entry.hash);
+    }
+
+    /// Returns the index of the item with the `key`.
+    pub(crate) fn index_of(&self, key: &T::Key) -> Option<usize> {
+        self.lookup.get(key).map(|&i| i as usize)
+    }
+
+    /// Returns the content hash of all items, which doesn't depend on their
+    /// order.
+    pub(crate) fn hash(&self) -> u64 {
+        self.hash
+    }
+
+    /// Returns the content hash of the item at the `index`.
+    pub(crate) fn hash_at(&self, index: usize) -> u64 {
+        self.entries[index].hash
+    }
+
+    /// Returns the number of entries including removed items.
+    pub(crate) fn len(&self) -> usize {
+        self.entries.len()
+    }
+
+    /// Returns the indices of all items that are not removed.
+    pub(crate) fn indices(&self) -> impl Iterator<Item = usize> + '_ {
+        self.entries
+            .iter()
+            .enumerate()
+            .filter(|(_, entry)| !entry.is_removed())
+            .map(|(i, _)| i)
+    }
+
+    /// Returns the keys of all items that are not removed without building
+    /// them.
+    pub(crate) fn keys(&self) -> impl Iterator<Item = (usize, T::Key)> + '_ {
+        self.indices().map(|i| (i, self.key(&self.entries[i])))
+    }
+
+    /// Returns the key of the item at the `index` without building it.
+    pub(crate) fn key_at(&self, index: usize) -> Option<T::Key> {
+        self.entries
+            .get(index)
+            .filter(|entry| !entry.is_removed())
+            .map(|entry| self.key(entry))
+    }
+
+    /// Returns the item at the `index` and builds it if needed.
+    pub(crate) fn get(&self, index: usize) -> Option<&Rc<T>> {
+        self.entries
+            .get(index)
+            .filter(|entry| !entry.is_removed())
+            .map(|entry| self.build(entry))
+    }
+
+    /// Returns an iterator over all items which are built if needed.
+    pub(crate) fn iter(&self) -> impl Iterator<Item = &Rc<T>> {
+        (0..self.len()).filter_map(|i| self.get(i))
+    }
+
+    /// Returns the coordinate of the item at the `index` without building it.
+    pub(crate) fn coordinate(&self, index: usize) -> Coordinate {
+        self.entries[index].coordinate
+    }
+
+    /// Returns the ident of the item at the `index` without building it.
+    pub(crate) fn ident(&self, index: usize) -> String {
+        let entry = &self.entries[index];
+        match (entry.item.get(), &entry.raw) {
+            (Some(item), _) => item.ident(),
+            (None, Some(raw)) => T::raw_ident(self.raw_line(raw)),
+            (None, None) => String::new(),
+        }
+    }
+
+    /// Returns the name of the item at the `index` without building it.
+    pub(crate) fn name(&self, index: usize) -> String {
+        let entry = &self.entries[index];
+        match (entry.item.get(), &entry.raw) {
+            (Some(item), _) => item.name().to_string(),
+            (None, Some(raw)) => T::raw_name(self.raw_line(raw)),
+            (None, None) => String::new(),
+        }
+    }
+
+    /// Merges the `other` records into these records.
+    ///
+    /// Records with the same key are merged into one according to the
+    /// [`Resolution`] of their cycles if they differ. Returned are the indices
+    /// of the other records within the merged records and the indices of the
+    /// conflicting records.
+    pub(crate) fn merge(&mut self, other: Records<T>) -> (Vec<u32>, Vec<u32>)
+    where
+        T: PartialEq,
+    {
+        let source_offset = self.sources.len() as u32;
+        let related_offset = self.related.len() as u32;
+        self.sources.extend(other.sources);
+        self.related.extend(other.related);
+
+        let mut remap = Vec::with_capacity(other.entries.len());
+        let mut conflicts = Vec::new();
+
+        for mut entry in other.entries {
+            if let Some(raw) = entry.raw.as_mut() {
+                raw.source += source_offset;
+                raw.related = raw.related.start + related_offset..raw.related.end + related_offset;
+            }
+
+            if entry.is_removed() {
+                remap.push(self.entries.len() as u32);
+                self.entries.push(entry);
+                continue;
+            }
+
+            let key = self.key(&entry);
+            match self.lookup.get(&key).copied() {
+                Some(i) => {
+                    remap.push(i);
+
+                    let (ours, theirs) =
+                        (self.build(&self.entries[i as usize]), self.build(&entry));
+                    if ours != theirs {
+                        match Resolution::new(ours.cycle(), theirs.cycle()) {
+                            Resolution::Replace => {
+                                self.unlink(i as usize);
+                                self.entries[i as usize] = entry;
+                                self.link(i as usize);
+                            }
+                            Resolution::Conflict => conflicts.push(i),
+                            Resolution::Keep => {}
+                        }
+                    }
+                }
+                None => {
+                    remap.push(self.entries.len() as u32);
+                    self.entries.push(entry);
+                    self.link(self.entries.len() - 1);
+                }
+            }
+        }
+
+        (remap, conflicts)
+    }
+
+    /// Shares the records that are unchanged in one of the `bases`.
+    ///
+    /// Records are compared by their key and source lines without building
+    /// them. An unchanged record refers to the line of the first base it's
+    /// found in and to its item if that's already built. Items that are only
+    /// built are shared if they are equal. Afterwards, the lines of the own
+    /// sources that are still needed are copied, so the sources themselves
+    /// are dropped and only the changed records are kept twice.
+    pub(crate) fn share(&mut self, bases: &[&Records<T>])
+    where
+        T: PartialEq,
+    {
+        let mut shared = false;
+
+        for i in 0..self.entries.len() {
+            if self.entries[i].is_removed() {
+                continue;
+            }
+
+            let key = self.key(&self.entries[i]);
+            let found = bases.iter().find_map(|base| {
+                let j = base.index_of(&key)?;
+                self.unchanged(i, base, j).then_some((*base, j))
+            });
+
+            if let Some((base, j)) = found {
+                self.point_at(i, base, j);
+                shared = true;
+            }
+        }
+
+        if shared {
+            let is_base = |source: &Source| {
+                bases
+                    .iter()
+                    .flat_map(|base| &base.sources)
+                    .any(|base_source| Rc::ptr_eq(&source.text, &base_source.text))
+            };
+            let own: Vec<bool> = self.sources.iter().map(|s| !is_base(s)).collect();
+            self.repack(&own);
+        }
+    }
+
+    /// Returns whether the entry at the `index` is unchanged compared to the
+    /// entry of the `base` at `base_index`.
+    fn unchanged(&self, index: usize, base: &Records<T>, base_index: usize) -> bool
+    where
+        T: PartialEq,
+    {
+        let (ours, theirs) = (&self.entries[index], &base.entries[base_index]);
+        match (&ours.raw, &theirs.raw) {
+            // the same line yields a different item if the declination is
+            // evaluated at another date
+            (Some(a), Some(b)) => {
+                self.raw_line(a) == base.raw_line(b)
+                    && self.raw_related(a).eq(base.raw_related(b))
+                    && (self.sources[a.source as usize].grid.date()
+                        == base.sources[b.source as usize].grid.date()
+                        || T::raw_states_mag_var(self.raw_line(a)))
+            }
+            _ => matches!(
+                (ours.item.get(), theirs.item.get()),
+                (Some(a), Some(b)) if a == b
+            ),
+        }
+    }
+
+    /// Points the entry at the `index` to the line and item of the entry of
+    /// the `base` at `base_index`.
+    fn point_at(&mut self, index: usize, base: &Records<T>, base_index: usize) {
+        let theirs = &base.entries[base_index];
+
+        if let Some(raw) = &theirs.raw {
+            let base_source = &base.sources[raw.source as usize];
+            let source = match self
+                .sources
+                .iter()
+                .position(|source| Rc::ptr_eq(&source.text, &base_source.text))
+            {
+                Some(source) => source,
+                None => {
+                    self.sources.push(base_source.clone());
+                    self.sources.len() - 1
+                }
+            };
+
+            let start = self.related.len() as u32;
+            self.related.extend_from_slice(
+                &base.related[raw.related.start as usize..raw.related.end as usize],
+            );
+
+            self.entries[index].raw = Some(Raw {
+                source: source as u32,
+                offset: raw.offset,
+                related: start..self.related.len() as u32,
+            });
+        }
+
+        if let Some(item) = theirs.item.get() {
+            self.entries[index].item = OnceCell::from(Rc::clone(item));
+        }
+    }
+
+    /// Copies the lines that are still referred to from the sources that are
+    /// selected by `repack`, so each of these sources keeps only its lines.
+    fn repack(&mut self, repack: &[bool]) {
+        let mut packed = vec![String::new(); self.sources.len()];
+        let mut offsets: HashMap<(u32, u32), u32> = HashMap::new();
+        let mut copy = |source: &Source, key: (u32, u32)| {
+            *offsets.entry(key).or_insert_with(|| {
+                let packed = &mut packed[key.0 as usize];
+                let offset = packed.len() as u32;
+                packed.push_str(line(&source.text, key.1));
+                packed.push('\n');
+                offset
+            })
+        };
+
+        for entry in &mut self.entries {
+            let Some(raw) = entry.raw.as_mut() else {
+                continue;
+            };
+
+            if !repack[raw.source as usize] {
+                continue;
+            }
+
+            let source = &self.sources[raw.source as usize];
+            raw.offset = copy(source, (raw.source, raw.offset));
+            for related in &mut self.related[raw.related.start as usize..raw.related.end as usize] {
+                *related = copy(source, (raw.source, *related));
+            }
+        }
+
+        for ((source, packed), &repack) in self.sources.iter_mut().zip(packed).zip(repack) {
+            if repack {
+                source.text = Rc::from(packed);
+            }
+        }
+    }
+
+    /// Returns the number of removed entries.
+    pub(crate) fn removed_count(&self) -> usize {
+        self.entries
+            .iter()
+            .filter(|entry| entry.is_removed())
+            .count()
+    }
+
+    /// Drops the removed entries together with the lines that no entry
+    /// refers to anymore.
+    ///
+    /// Returned is the new index of each entry or `None` if it was removed.
+    /// The indices keep their order. Sources of which less than half is
+    /// still referred to are repacked, so removing a location releases most
+    /// of its lines.
+    pub(crate) fn compact(&mut self) -> Vec<Option<u32>> {
+        let mut next = 0;
+        let remap: Vec<Option<u32>> = self
+            .entries
+            .iter()
+            .map(|entry| {
+                (!entry.is_removed()).then(|| {
+                    next += 1;
+                    next - 1
+                })
+            })
+            .collect();
+        self.entries.retain(|entry| !entry.is_removed());
+        self.lookup.retain(|_, i| match remap[*i as usize] {
+            Some(index) => {
+                *i = index;
+                true
+            }
+            None => false,
+        });
+
+        let mut related = Vec::new();
+        let mut used = vec![0; self.sources.len()];
+        for raw in self
+            .entries
+            .iter_mut()
+            .filter_map(|entry| entry.raw.as_mut())
+        {
+            let start = related.len() as u32;
+            let source = &self.sources[raw.source as usize].text;
+            for &offset in &self.related[raw.related.start as usize..raw.related.end as usize] {
+                related.push(offset);
+                used[raw.source as usize] += line(source, offset).len() + 1;
+            }
+            used[raw.source as usize] += line(source, raw.offset).len() + 1;
+            raw.related = start..related.len() as u32;
+        }
+        self.related = related;
+
+        let sparse: Vec<bool> = self
+            .sources
+            .iter()
+            .zip(&used)
+            .map(|(source, &used)| used * 2 < source.text.len())
+            .collect();
+        self.repack(&sparse);
+
+        // sources without any lines are dropped
+        let mut sources = Vec::new();
+        let source_remap: Vec<u32> = std::mem::take(&mut self.sources)
+            .into_iter()
+            .zip(&used)
+            .map(|(source, &used)| {
+                if used > 0 {
+                    sources.push(source);
+                }
+                sources.len().saturating_sub(1) as u32
+            })
+            .collect();
+        self.sources = sources;
+        for raw in self
+            .entries
+            .iter_mut()
+            .filter_map(|entry| entry.raw.as_mut())
+        {
+            raw.source = source_remap[raw.source as usize];
+        }
+
+        remap
+    }
+
+    /// Moves all records of `other` into `self`.
+    pub(crate) fn append(&mut self, other: Records<T>) {
+        let source_offset = self.sources.len() as u32;
+        let related_offset = self.related.len() as u32;
+
+        let entry_offset = self.entries.len() as u32;
+
+        self.sources.extend(other.sources);
+        self.related.extend(other.related);
+        self.entries
+            .extend(other.entries.into_iter().map(|mut entry| {
+                if let Some(raw) = entry.raw.as_mut() {
+                    raw.source += source_offset;
+                    raw.related =
+                        raw.related.start + related_offset..raw.related.end + related_offset;
+                }
+                entry
+            }));
+        self.lookup.extend(
+            other
+                .lookup
+                .into_iter()
+                .map(|(key, i)| (key, i + entry_offset)),
+        );
+        self.hash = self.hash.wrapping_add(other.hash);
+    }
+
+    /// Returns the number of items that are built.
+    #[cfg(test)]
+    pub(crate) fn built_count(&self) -> usize {
+        self.entries
+            .iter()
+            .filter(|entry| entry.item.get().is_some())
+            .count()
+    }
+
+    /// Returns the number of bytes of all sources.
+    #[cfg(test)]
+    pub(crate) fn source_len(&self) -> usize {
+        self.sources.iter().map(|source| source.text.len()).sum()
+    }
+
+    /// Returns whether the item at the `index` refers to the same line as the
+    /// item of `other` at `other_index`.
+    #[cfg(test)]
+    pub(crate) fn shares_line(&self, index: usize, other: &Records<T>, other_index: usize) -> bool {
+        match (&self.entries[index].raw, &other.entries[other_index].raw) {
+            (Some(a), Some(b)) => std::ptr::eq(self.raw_line(a), other.raw_line(b)),
+            _ => false,
+        }
+    }
+
+    /// Returns the item of the `entry` and builds it if needed.
+    fn build<'a>(&self, entry: &'a Entry<T>) -> &'a Rc<T> {
+        entry.item.get_or_init(|| {
+            let raw = entry.raw.as_ref().expect("record should be built or raw");
+            let grid = &self.sources[raw.source as usize].grid;
+            Rc::new(T::materialize(
+                self.raw_line(raw),
+                self.raw_related(raw),
+                grid,
+            ))
+        })
+    }
+
+    fn key(&self, entry: &Entry<T>) -> T::Key {
+        match (entry.item.get(), &entry.raw) {
+            (Some(item), _) => item.key(),
+            (None, Some(raw)) => T::raw_key(self.raw_line(raw)),
+            (None, None) => unreachable!("record should be built or raw"),
+        }
+    }
+
+    fn raw_line(&self, raw: &Raw) -> &str {
+        line(&self.sources[raw.source as usize].text, raw.offset)
+    }
+
+    fn raw_related<'a>(&'a self, raw: &'a Raw) -> impl Iterator<Item = &'a str> {
+        let source = &self.sources[raw.source as usize].text;
+        self.related[raw.related.start as usize..raw.related.end as usize]
+            .iter()
+            .map(|&offset| line(source, offset))
+    }
+}
+
+/// Returns the line starting at the `offset` of the `source`.
+fn line(source: &str, offset: u32) -> &str {
+    let line = &source[offset as usize..];
+    line.lines().next().unwrap_or_default()
+}
+
+impl<T: Materialize> Index<usize> for Records<T> {
+    type Output = Rc<T>;
+
+    fn index(&self, index: usize) -> &Self::Output {
+        self.get(index).expect("index should be within records")
+    }
+}
+
+/// Records are equal if their items are equal, regardless of whether they
+/// are built or not.
+impl<T: Materialize + PartialEq> PartialEq for Records<T> {
+    fn eq(&self, other: &Self) -> bool {
+        self.iter().eq(other.iter())
+    }
+}
+
+#[cfg(any(feature = "serde", test))]
+impl<T: Materialize> Records<T> {
+    /// Returns each slot with its item and content hash, or `None` if the
+    /// item is removed.
+    pub(crate) fn slots(&self) -> impl Iterator<Item = Option<(Rc<T>, u64)>> + '_ {
+        (0..self.len()).map(|i| self.get(i).map(|item| (Rc::clone(item), self.hash_at(i))))
+    }
+
+    /// Returns the records of the `slots`, keeping removed items as
+    /// tombstones.
+    pub(crate) fn from_slots(slots: impl IntoIterator<Item = Option<(Rc<T>, u64)>>) -> Self {
+        let mut records = Self::default();
+        for slot in slots {
+            match slot {
+                Some((item, hash)) => {
+                    records.entries.push(Entry {
+                        raw: None,
+                        coordinate: item.coordinate(),
+                        hash,
+                        item: OnceCell::from(item),
+                    });
+                    records.link(records.entries.len() - 1);
+                }
+                None => records.entries.push(Entry {
+                    raw: None,
+                    coordinate: Coordinate::default(),
+                    hash: 0,
+                    item: OnceCell::new(),
+                }),
+            }
+        }
+        records
+    }
+}
+
+/// Records are serialized as their slots with the item and its content hash,
+/// since the raw lines the hash is taken from aren't kept. Removed items are
+/// kept as empty slots, so the indices of the airways and procedures still
+/// refer to the same items.
+#[cfg(feature = "serde")]
+impl<T: Materialize + Serialize> Serialize for Records<T> {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        serializer.collect_seq(self.slots())
+    }
+}
+
+#[cfg(feature = "serde")]
+impl<'de, T: Materialize + Deserialize<'de>> Deserialize<'de> for Records<T> {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        let slots = Vec::<Option<(Rc<T>, u64)>>::deserialize(deserializer)?;
+        Ok(Self::from_slots(slots))
+    }
+}
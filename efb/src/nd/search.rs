@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::collections::BTreeSet;
+
+use super::records::Records;
+use super::{Airport, Waypoint};
+
+/// A reference into the airports or waypoints of the navigation data.
+///
+/// Waypoints are ordered before airports, thus, a waypoint wins over an
+/// airport with the same ident.
+#[derive(Copy, Clone, Eq, PartialEq, Ord, PartialOrd, Hash, Debug)]
+pub(crate) enum Entry {
+    Waypoint(u32),
+    Airport(u32),
+}
+
+/// Index to search navigation aids by the prefix of their ident or name.
+///
+/// The idents and the tokens of the airport names and waypoint descriptions
+/// are kept in ordered sets. All entries starting with a prefix are adjacent
+/// and found within a range of the set. Single entries are inserted or
+/// removed in logarithmic time, e.g. when a delta is applied.
+#[derive(Clone, Debug, Default)]
+pub(crate) struct SearchIndex {
+    idents: BTreeSet<(String, Entry)>,
+    names: BTreeSet<(String, Entry)>,
+}
+
+impl SearchIndex {
+    pub(crate) fn new(airports: &Records<Airport>, waypoints: &Records<Waypoint>) -> Self {
+        let mut idents: Vec<(String, Entry)> = Vec::with_capacity(airports.len() + waypoints.len());
+        let mut names: Vec<(String, Entry)> = Vec::new();
+
+        for i in waypoints.indices() {
+            let entry = Entry::Waypoint(i as u32);
+            idents.push((waypoints.ident(i), entry));
+            names.extend(tokens(&waypoints.name(i)).map(|token| (token, entry)));
+        }
+
+        for i in airports.indices() {
+            let entry = Entry::Airport(i as u32);
+            idents.push((airports.ident(i), entry));
+            names.extend(tokens(&airports.name(i)).map(|token| (token, entry)));
+        }
+
+        // sets are built in linear time from sorted entries
+        idents.sort_unstable();
+        names.sort_unstable();
+
+        Self {
+            idents: idents.into_iter().collect(),
+            names: names.into_iter().collect(),
+        }
+    }
+
+    /// Adds the `entry` with its `ident` and `name`.
+    pub(crate) fn insert(&mut self, ident: String, name: &str, entry: Entry) {
+        self.idents.insert((ident, entry));
+        self.names.extend(tokens(name).map(|token| (token, entry)));
+    }
+
+    /// Removes the `entry` with its `ident` and `name`.
+    pub(crate) fn remove(&mut self, ident: String, name: &str, entry: Entry) {
+        self.idents.remove(&(ident, entry));
+        for token in tokens(name) {
+            self.names.remove(&(token, entry));
+        }
+    }
+
+    /// Returns the entries whose ident is equal to `ident`.
+    pub(crate) fn get<'a>(&'a self, ident: &'a str) -> impl Iterator<Item = Entry> + 'a {
+        prefix_range(&self.idents, ident)
+            .take_while(move |(s, _)| s == ident)
+            .map(|(_, entry)| *entry)
+    }
+
+    /// Returns the entries whose ident or a token of their name starts with
+    /// the upper case `prefix`. An entry might be returned more than once.
+    pub(crate) fn prefix<'a>(&'a self, prefix: &'a str) -> impl Iterator<Item = Entry> + 'a {
+        prefix_range(&self.idents, prefix)
+            .chain(prefix_range(&self.names, prefix))
+            .map(|(_, entry)| *entry)
+    }
+}
+
+fn prefix_range<'a>(
+    entries: &'a BTreeSet<(String, Entry)>,
+    prefix: &'a str,
+) -> impl Iterator<Item = &'a (String, Entry)> + 'a {
+    // waypoints are the smallest entries
+    entries
+        .range((prefix.to_string(), Entry::Waypoint(0))..)
+        .take_while(move |(s, _)| s.starts_with(prefix))
+}
+
+/// Splits a name into its upper case words.
+fn tokens(name: &str) -> impl Iterator<Item = String> + '_ {
+    name.split(|c: char| !c.is_alphanumeric())
+        .filter(|token| !token.is_empty())
+        .map(|token| token.to_uppercase())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn index() -> SearchIndex {
+        let entries = [
+            ("DHN1", Entry::Waypoint(0)),
+            ("EDDH", Entry::Airport(0)),
+            ("EDDF", Entry::Airport(1)),
+            ("EDHF", Entry::Airport(2)),
+        ];
+
+        SearchIndex {
+            idents: entries.iter().map(|(s, e)| (s.to_string(), *e)).collect(),
+            names: BTreeSet::from([
+                (String::from("FRANKFURT"), Entry::Airport(1)),
+                (String::from("HAMBURG"), Entry::Airport(0)),
+            ]),
+        }
+    }
+
+    #[test]
+    fn finds_exact_ident() {
+        let index = index();
+        assert_eq!(
+            index.get("EDDH").collect::<Vec<_>>(),
+            vec![Entry::Airport(0)]
+        );
+        assert_eq!(index.get("EDD").next(), None);
+    }
+
+    #[test]
+    fn finds_ident_and_name_prefix() {
+        let index = index();
+        assert_eq!(
+            index.prefix("EDD").collect::<Vec<_>>(),
+            vec![Entry::Airport(1), Entry::Airport(0)]
+        );
+        assert_eq!(
+            index.prefix("HAM").collect::<Vec<_>>(),
+            vec![Entry::Airport(0)]
+        );
+    }
+
+    #[test]
+    fn updates_entries() {
+        let mut index = index();
+        index.remove(String::from("EDDH"), "Hamburg", Entry::Airport(0));
+        index.insert(String::from("EDDH"), "Hamburg Airport", Entry::Airport(3));
+
+        assert_eq!(
+            index.get("EDDH").collect::<Vec<_>>(),
+            vec![Entry::Airport(3)]
+        );
+        assert_eq!(
+            index.prefix("AIR").collect::<Vec<_>>(),
+            vec![Entry::Airport(3)]
+        );
+        assert_eq!(
+            index.prefix("HAM").collect::<Vec<_>>(),
+            vec![Entry::Airport(3)]
+        );
+    }
+
+    #[test]
+    fn splits_name_into_tokens() {
+        assert_eq!(
+            tokens("Itzehoe/Hungriger Wolf").collect::<Vec<_>>(),
+            vec!["ITZEHOE", "HUNGRIGER", "WOLF"]
+        );
+    }
+}
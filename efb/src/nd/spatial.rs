@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::collections::HashMap;
+
+use super::records::{Materialize, Records};
+use super::search::Entry;
+use super::{Airport, Waypoint};
+use crate::geom::{BBox, CellId};
+
+/// The level of the cells, which are about 0.18° wide and 0.09° high.
+pub(crate) const LEVEL: u8 = 11;
+
+/// Index of airports and waypoints by their position.
+///
+/// The records are grouped into [cells], thus an area is queried by visiting
+/// the records of the cells that cover it. Coordinates are read from the
+/// records without building lazy items.
+///
+/// [cells]: CellId
+#[derive(Clone, Debug, Default)]
+pub(crate) struct SpatialIndex(HashMap<CellId, Vec<Entry>>);
+
+impl SpatialIndex {
+    pub(crate) fn new(airports: &Records<Airport>, waypoints: &Records<Waypoint>) -> Self {
+        let mut index = Self::default();
+        index.insert_all(airports, Entry::Airport);
+        index.insert_all(waypoints, Entry::Waypoint);
+        index
+    }
+
+    fn insert_all<T: Materialize>(&mut self, records: &Records<T>, entry: fn(u32) -> Entry) {
+        for i in records.indices() {
+            self.0
+                .entry(CellId::new(&records.coordinate(i), LEVEL))
+                .or_default()
+                .push(entry(i as u32));
+        }
+    }
+
+    /// Returns the entries in the cells that cover the `bbox`.
+    pub(crate) fn within(&self, bbox: &BBox) -> impl Iterator<Item = Entry> + '_ {
+        CellId::covering(bbox, LEVEL)
+            .filter_map(|cell| self.0.get(&cell))
+            .flatten()
+            .copied()
+    }
+}
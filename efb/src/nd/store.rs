@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use chrono::NaiveDate;
+
+use super::{AiracCycle, NavigationData};
+
+/// Navigation data of multiple AIRAC cycles.
+///
+/// Around a cycle changeover, the current and next cycle are needed to plan
+/// flights before and after the changeover. Since most records don't change
+/// between two cycles, the store keeps records that are equal in consecutive
+/// cycles only once and the navigation data of each cycle refers to them.
+///
+/// # Examples
+///
+/// ```
+/// # use chrono::NaiveDate;
+/// # use efb::nd::{AiracCycle, CycleStore, NavigationData};
+/// # fn plan(current: NavigationData, next: NavigationData) {
+/// let mut store = CycleStore::new();
+/// store.insert(AiracCycle::new(25, 9), current);
+/// store.insert(AiracCycle::new(25, 10), next);
+///
+/// // the navigation data of AIRAC 2510 which starts 2025-10-02
+/// let date = NaiveDate::from_ymd_opt(2025, 10, 2).unwrap();
+/// let nd = store.at(date);
+/// # }
+/// ```
+#[derive(Clone, PartialEq, Debug, Default)]
+pub struct CycleStore {
+    // sorted by the cycle
+    cycles: Vec<(AiracCycle, NavigationData)>,
+}
+
+impl CycleStore {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Inserts the navigation data `nd` of the `cycle`.
+    ///
+    /// Records that are unchanged in the preceding or succeeding cycle are
+    /// shared with it. Any navigation data of the same cycle is replaced.
+    pub fn insert(&mut self, cycle: AiracCycle, mut nd: NavigationData) {
+        let i = match self.cycles.binary_search_by_key(&cycle, |(c, _)| *c) {
+            Ok(i) => {
+                self.cycles.remove(i);
+                i
+            }
+            Err(i) => i,
+        };
+
+        let neighbours: Vec<_> = i
+            .checked_sub(1)
+            .and_then(|i| self.cycles.get(i))
+            .into_iter()
+            .chain(self.cycles.get(i))
+            .map(|(_, nd)| nd)
+            .collect();
+
+        nd.share(&neighbours);
+        self.cycles.insert(i, (cycle, nd));
+    }
+
+    /// Removes the navigation data of the `cycle`, e.g. once it's expired.
+    pub fn remove(&mut self, cycle: &AiracCycle) -> Option<NavigationData> {
+        let i = self.cycles.binary_search_by_key(cycle, |(c, _)| *c).ok()?;
+        Some(self.cycles.remove(i).1)
+    }
+
+    /// Returns the navigation data of the `cycle`.
+    pub fn get(&self, cycle: &AiracCycle) -> Option<&NavigationData> {
+        self.cycles
+            .binary_search_by_key(cycle, |(c, _)| *c)
+            .ok()
+            .map(|i| &self.cycles[i].1)
+    }
+
+    /// Returns the navigation data of the cycle that is effective at the
+    /// `date`.
+    pub fn at(&self, date: NaiveDate) -> Option<&NavigationData> {
+        self.get(&AiracCycle::at(date)?)
+    }
+
+    /// Returns an iterator over the stored cycles in ascending order.
+    pub fn cycles(&self) -> impl Iterator<Item = &AiracCycle> {
+        self.cycles.iter().map(|(cycle, _)| cycle)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::rc::Rc;
+
+    use super::*;
+    use crate::nd::{Filter, NavAid};
+
+    const EDDH: &str = "SEURP EDDHEDA        0        N N53374900E009591762E002000053                   P    MWGE    HAMBURG                       356462409";
+    const EDHF: &str = "SEURP EDHFEDA        0        N N53593300E009343600E000000082                   P    MWGE    ITZEHOE/HUNGRIGER WOLF        320782409";
+    const EDHF_2510: &str = "SEURP EDHFEDA        0        N N53593400E009343600E000000082                   P    MWGE    ITZEHOE/HUNGRIGER WOLF        320782510";
+
+    const AIRSPACES: &str = r#"AC D
+AN TMA BREMEN A
+AH FL 65
+AL 1500msl
+DP 53:06:04 N 8:58:30 E
+DP 53:06:10 N 9:04:45 E
+DP 52:58:13 N 9:05:04 E
+DP 53:06:04 N 8:58:30 E
+AC D
+AN TMA BREMEN B
+AH FL 65
+AL 2500msl
+DP 53:16:04 N 8:58:30 E
+DP 53:16:10 N 9:04:45 E
+DP 53:08:13 N 9:05:04 E
+DP 53:16:04 N 8:58:30 E
+"#;
+
+    fn airport(nd: &NavigationData, ident: &str) -> Rc<crate::nd::Airport> {
+        match nd.find(ident) {
+            Some(NavAid::Airport(aprt)) => aprt,
+            _ => panic!("{ident} should be an airport"),
+        }
+    }
+
+    #[test]
+    fn shares_unchanged_records() {
+        let nd = |lines: [&str; 2]| {
+            NavigationData::try_from_arinc424(&lines.join("\n")).expect("records should be valid")
+        };
+
+        let mut store = CycleStore::new();
+        store.insert(AiracCycle::new(25, 10), nd([EDDH, EDHF_2510]));
+        store.insert(AiracCycle::new(25, 9), nd([EDDH, EDHF]));
+
+        let date = |day| NaiveDate::from_ymd_opt(2025, 10, day).expect("date should be valid");
+        let current = store.at(date(1)).expect("AIRAC 2509 should be stored");
+        let next = store.at(date(2)).expect("AIRAC 2510 should be stored");
+
+        assert!(Rc::ptr_eq(
+            &airport(current, "EDDH"),
+            &airport(next, "EDDH")
+        ));
+        assert!(!Rc::ptr_eq(
+            &airport(current, "EDHF"),
+            &airport(next, "EDHF")
+        ));
+        assert_eq!(airport(next, "EDHF").cycle, Some(AiracCycle::new(25, 10)));
+        assert_eq!(
+            store.cycles().collect::<Vec<_>>(),
+            vec![&AiracCycle::new(25, 9), &AiracCycle::new(25, 10)]
+        );
+    }
+
+    #[test]
+    fn shares_unchanged_lazy_records_without_building_them() {
+        let nd = |lines: [&str; 2]| {
+            NavigationData::try_from_arinc424_lazy(lines.join("\n"), &Filter::default())
+                .expect("records should be valid")
+        };
+
+        // the successor is inserted first, thus, the current cycle shares
+        // with it
+        let mut store = CycleStore::new();
+        store.insert(AiracCycle::new(25, 10), nd([EDDH, EDHF_2510]));
+        store.insert(AiracCycle::new(25, 9), nd([EDDH, EDHF]));
+
+        let current = store
+            .get(&AiracCycle::new(25, 9))
+            .expect("AIRAC 2509 should be stored");
+        let next = store
+            .get(&AiracCycle::new(25, 10))
+            .expect("AIRAC 2510 should be stored");
+
+        assert_eq!(current.airports.built_count(), 0);
+        assert_eq!(next.airports.built_count(), 0);
+        assert!(current.airports.shares_line(0, &next.airports, 0));
+        assert!(!current.airports.shares_line(1, &next.airports, 1));
+
+        assert_eq!(airport(current, "EDHF").cycle, Some(AiracCycle::new(24, 9)));
+        assert_eq!(airport(next, "EDHF").cycle, Some(AiracCycle::new(25, 10)));
+        assert_eq!(airport(current, "EDDH"), airport(next, "EDDH"));
+    }
+
+    #[test]
+    fn shares_unchanged_airspaces_airways_and_procedures() {
+        let airspaces = |floor: &str| {
+            NavigationData::try_from_openair(&AIRSPACES.replace("AL 1500msl", floor))
+                .expect("airspaces should be valid")
+        };
+        let nd = |floor: &str| {
+            let mut nd = crate::fixtures::nd();
+            nd.append(airspaces(floor));
+            nd
+        };
+
+        let mut store = CycleStore::new();
+        store.insert(AiracCycle::new(25, 9), nd("AL 1500msl"));
+        store.insert(AiracCycle::new(25, 10), nd("AL 2000msl"));
+
+        let current = store
+            .get(&AiracCycle::new(25, 9))
+            .expect("AIRAC 2509 should be stored");
+        let next = store
+            .get(&AiracCycle::new(25, 10))
+            .expect("AIRAC 2510 should be stored");
+
+        // only the changed TMA BREMEN A is kept twice
+        assert!(!Rc::ptr_eq(&current.airspaces[0], &next.airspaces[0]));
+        assert!(Rc::ptr_eq(&current.airspaces[1], &next.airspaces[1]));
+        assert!(Rc::ptr_eq(&current.airways, &next.airways));
+        assert!(Rc::ptr_eq(&current.procedures, &next.procedures));
+    }
+}
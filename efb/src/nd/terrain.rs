@@ -0,0 +1,315 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use std::cell::RefCell;
+use std::collections::HashMap;
+use std::fs;
+use std::path::PathBuf;
+use std::rc::Rc;
+
+use crate::error::Error;
+use crate::geom::{Coordinate, Corridor};
+use crate::measurements::Length;
+
+/// The value of a sample without elevation data.
+const VOID: i16 = i16::MIN;
+
+/// The number of samples per side of a block whose maximum is kept.
+const BLOCK: usize = 32;
+
+/// A grid of terrain elevations read from tiles of one degree.
+///
+/// Each tile covers one degree of latitude and longitude from its south-west
+/// corner and is in the [HGT] format of the SRTM: a square of big-endian
+/// elevations in meters, written row by row from north to south. Tiles can
+/// be inserted from memory or are read from a directory on first access,
+/// where each file is named after the tile's corner, e.g. `N53E009.hgt`.
+/// Missing tiles have no elevation, which is the case for open water.
+///
+/// Along with the samples, a tile keeps the maximum of each block of samples.
+/// Queries of the highest terrain along a line skip blocks that are lower
+/// than the highest elevation found so far or that are completely within the
+/// corridor, thus only few samples at the corridor's edges are visited.
+///
+/// [HGT]: https://www.usgs.gov/centers/eros/science/usgs-eros-archive-digital-elevation-shuttle-radar-topography-mission-srtm-1
+#[derive(Default)]
+pub struct TerrainGrid {
+    dir: Option<PathBuf>,
+    tiles: RefCell<HashMap<(i16, i16), Option<Rc<Tile>>>>,
+}
+
+impl TerrainGrid {
+    /// Creates an empty grid to which tiles are inserted.
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Creates a grid that reads its tiles from the HGT files in the `dir`.
+    pub fn from_dir(dir: impl Into<PathBuf>) -> Self {
+        Self {
+            dir: Some(dir.into()),
+            tiles: RefCell::default(),
+        }
+    }
+
+    /// Inserts the `hgt` tile whose south-west corner is at the `latitude`
+    /// and `longitude`.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`UnexpectedTerrainTile`] if the `hgt` bytes are not a square
+    /// of elevations.
+    ///
+    /// [`UnexpectedTerrainTile`]: Error::UnexpectedTerrainTile
+    pub fn insert_hgt(&mut self, latitude: i16, longitude: i16, hgt: &[u8]) -> Result<(), Error> {
+        let tile = Tile::from_hgt(hgt)?;
+        self.tiles
+            .get_mut()
+            .insert((latitude, longitude), Some(Rc::new(tile)));
+        Ok(())
+    }
+
+    /// Returns the terrain elevation at the `point` or `None` if no tile
+    /// covers the point.
+    pub fn elevation(&self, point: &Coordinate) -> Option<Length> {
+        let corner = (
+            point.latitude.floor() as i16,
+            point.longitude.floor() as i16,
+        );
+        let tile = self.tile(corner)?;
+        let (row, col) = tile.index(corner, point.latitude, point.longitude);
+
+        match tile.samples[row * tile.size + col] {
+            VOID => None,
+            value => Some(Length::m(value as f32)),
+        }
+    }
+
+    /// Returns the highest terrain elevation within the `corridor` to either
+    /// side of the great circle from `from` to `to`.
+    ///
+    /// The line is split into parts of up to 60 NM that are treated as
+    /// straight lines. `None` is returned if no tile covers the corridor.
+    pub fn max_elevation(
+        &self,
+        from: &Coordinate,
+        to: &Coordinate,
+        corridor: Length,
+    ) -> Option<Length> {
+        let mut highest = VOID;
+
+        for part in Corridor::along(from, to, corridor) {
+            for lat in part.south.floor() as i16..=part.north.floor() as i16 {
+                for lon in part.west.floor() as i16..=part.east.floor() as i16 {
+                    if let Some(tile) = self.tile((lat, lon)) {
+                        tile.max_near((lat, lon), &part, &mut highest);
+                    }
+                }
+            }
+        }
+
+        (highest != VOID).then(|| Length::m(highest as f32))
+    }
+
+    fn tile(&self, corner: (i16, i16)) -> Option<Rc<Tile>> {
+        self.tiles
+            .borrow_mut()
+            .entry(corner)
+            .or_insert_with(|| {
+                let path = self.dir.as_ref()?.join(hgt_name(corner));
+                // unreadable or malformed files are treated like missing tiles
+                let hgt = fs::read(path).ok()?;
+                Tile::from_hgt(&hgt).ok().map(Rc::new)
+            })
+            .clone()
+    }
+}
+
+fn hgt_name((lat, lon): (i16, i16)) -> String {
+    format!(
+        "{}{:02}{}{:03}.hgt",
+        if lat < 0 { 'S' } else { 'N' },
+        lat.unsigned_abs(),
+        if lon < 0 { 'W' } else { 'E' },
+        lon.unsigned_abs()
+    )
+}
+
+/// A tile of elevation samples with the maximum of each block.
+struct Tile {
+    size: usize,
+    samples: Box<[i16]>,
+    blocks: Box<[i16]>,
+}
+
+impl Tile {
+    fn from_hgt(hgt: &[u8]) -> Result<Self, Error> {
+        let size = ((hgt.len() / 2) as f64).sqrt() as usize;
+        if size < 2 || size * size * 2 != hgt.len() {
+            return Err(Error::UnexpectedTerrainTile);
+        }
+
+        let samples: Box<[i16]> = hgt
+            .chunks_exact(2)
+            .map(|b| i16::from_be_bytes([b[0], b[1]]))
+            .collect();
+
+        let per_side = size.div_ceil(BLOCK);
+        let mut blocks = vec![VOID; per_side * per_side].into_boxed_slice();
+        for (row, line) in samples.chunks_exact(size).enumerate() {
+            for (col, &value) in line.iter().enumerate() {
+                let block = &mut blocks[(row / BLOCK) * per_side + col / BLOCK];
+                *block = (*block).max(value);
+            }
+        }
+
+        Ok(Self {
+            size,
+            samples,
+            blocks,
+        })
+    }
+
+    /// The degrees between two samples.
+    fn spacing(&self) -> f32 {
+        1.0 / (self.size - 1) as f32
+    }
+
+    /// Returns the row and column of the sample closest to the point.
+    fn index(&self, (lat, lon): (i16, i16), latitude: f32, longitude: f32) -> (usize, usize) {
+        let last = (self.size - 1) as f32;
+        let row = ((lat as f32 + 1.0 - latitude) * last)
+            .round()
+            .clamp(0.0, last);
+        let col = ((longitude - lon as f32) * last).round().clamp(0.0, last);
+        (row as usize, col as usize)
+    }
+
+    /// Raises the `highest` elevation to the highest sample of this tile
+    /// within the corridor.
+    fn max_near(&self, corner: (i16, i16), part: &Corridor, highest: &mut i16) {
+        let spacing = self.spacing();
+        let north = corner.0 as f32 + 1.0;
+        let west = corner.1 as f32;
+        let (row_min, col_min) = self.index(corner, part.north, part.west);
+        let (row_max, col_max) = self.index(corner, part.south, part.east);
+        let per_side = self.size.div_ceil(BLOCK);
+
+        for block_row in row_min / BLOCK..=row_max / BLOCK {
+            for block_col in col_min / BLOCK..=col_max / BLOCK {
+                let block_max = self.blocks[block_row * per_side + block_col];
+                if block_max <= *highest {
+                    continue;
+                }
+
+                let rows = block_row * BLOCK..((block_row + 1) * BLOCK).min(self.size);
+                let cols = block_col * BLOCK..((block_col + 1) * BLOCK).min(self.size);
+
+                // the block's center and half diagonal in the corridor's plane
+                let lat = north - (rows.start + rows.end - 1) as f32 * spacing / 2.0;
+                let lon = west + (cols.start + cols.end - 1) as f32 * spacing / 2.0;
+                let half = part.project(
+                    (rows.len() - 1) as f32 * spacing / 2.0,
+                    (cols.len() - 1) as f32 * spacing / 2.0,
+                );
+                let half = half.0.hypot(half.1);
+                let dist = part.dist(lat, lon);
+
+                if dist - half > part.radius {
+                    continue;
+                } else if dist + half <= part.radius {
+                    *highest = block_max;
+                    continue;
+                }
+
+                for row in rows.clone() {
+                    let lat = north - row as f32 * spacing;
+                    for col in cols.clone() {
+                        let value = self.samples[row * self.size + col];
+                        if value > *highest
+                            && part.dist(lat, west + col as f32 * spacing) <= part.radius
+                        {
+                            *highest = value;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Returns a tile of 1201 samples per side that is flat at `base` with a
+    /// single peak at the sample's row and column.
+    fn hgt(base: i16, peak: (usize, usize, i16)) -> Vec<u8> {
+        let size = 1201;
+        let mut samples = vec![base; size * size];
+        samples[peak.0 * size + peak.1] = peak.2;
+        samples.iter().flat_map(|s| s.to_be_bytes()).collect()
+    }
+
+    #[test]
+    fn names_tiles_by_corner() {
+        assert_eq!(hgt_name((53, 9)), "N53E009.hgt");
+        assert_eq!(hgt_name((-1, -72)), "S01W072.hgt");
+    }
+
+    #[test]
+    fn rejects_malformed_tile() {
+        let mut terrain = TerrainGrid::new();
+        assert_eq!(
+            terrain.insert_hgt(53, 9, &[0; 3]),
+            Err(Error::UnexpectedTerrainTile)
+        );
+    }
+
+    #[test]
+    fn elevation_at_point() {
+        let mut terrain = TerrainGrid::new();
+        // the peak is in the tile's center
+        terrain
+            .insert_hgt(53, 9, &hgt(10, (600, 600, 500)))
+            .expect("tile should be valid");
+
+        assert_eq!(
+            terrain.elevation(&coord!(53.5, 9.5)),
+            Some(Length::m(500.0))
+        );
+        assert_eq!(terrain.elevation(&coord!(53.2, 9.2)), Some(Length::m(10.0)));
+        assert_eq!(terrain.elevation(&coord!(52.5, 9.5)), None);
+    }
+
+    #[test]
+    fn max_elevation_within_corridor() {
+        let mut terrain = TerrainGrid::new();
+        terrain
+            .insert_hgt(53, 9, &hgt(10, (600, 600, 500)))
+            .expect("tile should be valid");
+
+        // the line passes 0.1° (6 NM) south of the peak
+        let (from, to) = (coord!(53.4, 9.1), coord!(53.4, 9.9));
+        let max = |nm| terrain.max_elevation(&from, &to, Length::nm(nm));
+
+        assert_eq!(max(7.0), Some(Length::m(500.0)));
+        assert_eq!(max(5.0), Some(Length::m(10.0)));
+        assert_eq!(
+            terrain.max_elevation(&coord!(50.0, 0.0), &coord!(50.5, 0.5), Length::nm(5.0)),
+            None
+        );
+    }
+}
@@ -40,6 +40,19 @@ pub enum Region {
     TerminalArea([u8; 4]),
 }
 
+impl Region {
+    /// Returns the prefix of idents within the region, which are the last two
+    /// characters of the airport ident for a terminal area.
+    pub(crate) fn prefix(&self) -> String {
+        match self {
+            Region::Enroute => String::default(),
+            Region::TerminalArea(airport_ident) => {
+                String::from_utf8(vec![airport_ident[2], airport_ident[3]]).unwrap_or_default()
+            }
+        }
+    }
+}
+
 #[derive(Clone, PartialEq, Debug)]
 #[cfg_attr(feature = "serde", derive(Serialize, Deserialize))]
 pub struct Waypoint {
@@ -60,17 +73,16 @@ impl Fix for Waypoint {
     /// example, a waypoint with ident `W1` at the Hamburg terminal area `EDDH`
     /// would be `DHW1`.
     fn ident(&self) -> String {
-        let region_prefix: String = match self.region {
-            Region::Enroute => String::default(),
-            Region::TerminalArea(airport_ident) => {
-                String::from_utf8(vec![airport_ident[2], airport_ident[3]]).unwrap_or_default()
-            }
-        };
-
-        region_prefix + &self.fix_ident
+        self.region.prefix() + &self.fix_ident
     }
 
     fn coordinate(&self) -> Coordinate {
         self.coordinate
     }
+
+    /// Returns the stated magnetic variation or the declination at the epoch
+    /// of the data the waypoint is loaded from.
+    fn mag_var(&self) -> MagneticVariation {
+        self.mag_var
+    }
 }
@@ -18,7 +18,7 @@ use serde::{Deserialize, Serialize};
 
 use crate::fp::Performance;
 use crate::measurements::{Angle, AngleUnit, Duration, Length, LengthUnit, Speed};
-use crate::nd::{Fix, NavAid};
+use crate::nd::{Fix, NavAid, ObstacleClearance, Obstacles, TerrainGrid};
 use crate::{Fuel, VerticalDistance, Wind};
 
 /// A leg `from` one point `to` another.
@@ -156,6 +156,42 @@ impl Leg {
         self.ete.as_ref()
     }
 
+    /// The minimum safe altitude (MSA) that clears the highest terrain within
+    /// the `corridor` to either side of the leg by the `clearance`.
+    ///
+    /// The altitude is rounded up to the next 100 ft. `None` is returned if
+    /// the `terrain` has no elevation within the corridor.
+    pub fn msa(
+        &self,
+        terrain: &TerrainGrid,
+        corridor: Length,
+        clearance: Length,
+    ) -> Option<VerticalDistance> {
+        let elevation =
+            terrain.max_elevation(&self.from.coordinate(), &self.to.coordinate(), corridor)?;
+        let ft = (elevation + clearance).convert_to(LengthUnit::Feet);
+        let msa = (ft.value().max(0.0) / 100.0).ceil() * 100.0;
+
+        Some(VerticalDistance::Msl(msa.min(u16::MAX as f32) as u16))
+    }
+
+    /// Returns up to `limit` of the highest obstacles within the `buffer` to
+    /// either side of the leg and their clearance below the leg's level.
+    pub fn obstacles<'a>(
+        &self,
+        obstacles: &'a Obstacles,
+        buffer: Length,
+        limit: usize,
+    ) -> Vec<ObstacleClearance<'a>> {
+        obstacles.highest(
+            &self.from.coordinate(),
+            &self.to.coordinate(),
+            buffer,
+            self.level.as_ref(),
+            limit,
+        )
+    }
+
     /// The [Fuel] consumed on the leg with the given [Performance].
     pub fn fuel(&self, perf: &Performance) -> Option<Fuel> {
         match (self.level, self.ete) {
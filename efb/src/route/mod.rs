@@ -23,9 +23,13 @@ use crate::{VerticalDistance, Wind};
 
 mod accumulator;
 mod leg;
+mod tracker;
+mod wire;
 
 pub use accumulator::TotalsToLeg;
 pub use leg::Leg;
+pub use tracker::Tracker;
+pub use wire::{WireElement, WireNavAid, WireReader};
 
 #[derive(Clone, PartialEq, Debug)]
 pub enum RouteElement {
@@ -65,6 +69,27 @@ pub enum RouteElement {
 /// we would have wind from south-east (135°) on the leg from EDDH to DHD, but
 /// the wind would turn to south (180°) for the remaining legs.
 ///
+/// Airways are entered between the fix where the airway is joined and the fix
+/// where it is left:
+///
+/// ```text
+/// N0107 EDDH DHN UL126 XYZ EDDF
+/// ```
+///
+/// The airway `UL126` is expanded to all fixes along the airway from `DHN` to
+/// `XYZ`.
+///
+/// Terminal procedures are entered by their ident with an optional transition
+/// separated by a dot:
+///
+/// ```text
+/// N0107 EDDH RWY33 ABBE1D.ABBEN UL126 CELLE DELT1H EDHF RWY20
+/// ```
+///
+/// A departure is flown from the origin and its takeoff runway, whereas an
+/// arrival or approach is flown into the next airport of the route and its
+/// landing runway.
+///
 /// [`leg`]: Leg
 /// [`fixes`]: crate::nd::Fix
 #[derive(Clone, PartialEq, Debug, Default)]
@@ -86,10 +111,24 @@ impl Route {
     pub fn decode(&mut self, route: &str, nd: &NavigationData) -> Result<(), Error> {
         let mut elements: Vec<RouteElement> = Vec::new();
 
+        let mut tokens = route.split_whitespace();
+
         // TODO level and speed needs to be properly update from decoder
-        for element in route.split_whitespace() {
+        while let Some(element) = tokens.next() {
             if let Some(navaid) = nd.find(element) {
                 elements.push(RouteElement::NavAid(navaid));
+            } else if nd.airways().find(element).next().is_some() {
+                // an airway is expanded to the fixes up to the next element
+                let from = match elements.last() {
+                    Some(RouteElement::NavAid(from)) => from,
+                    _ => return Err(Error::UnexpectedRouteElement(element.to_string())),
+                };
+                let to = tokens
+                    .next()
+                    .ok_or(Error::UnexpectedRouteElement(element.to_string()))?;
+
+                let fixes = nd.airway_segment(from, element, to)?;
+                elements.extend(fixes.into_iter().map(RouteElement::NavAid));
             } else if let Ok(value) = element.parse::<VerticalDistance>() {
                 self.level.get_or_insert(value);
                 elements.push(RouteElement::Level(value));
@@ -113,6 +152,21 @@ impl Route {
                 } else {
                     return Err(Error::UnexpectedRunwayInRoute(element.to_string()));
                 }
+            } else if let Some(fixes) =
+                Self::expand_procedure(element, &elements, tokens.clone(), nd)
+            {
+                let mut fixes = fixes?.into_iter().peekable();
+
+                // the procedure might start at the fix where the route ends
+                if let (Some(RouteElement::NavAid(last)), Some(first)) =
+                    (elements.last(), fixes.peek())
+                {
+                    if last.ident() == first.ident() {
+                        fixes.next();
+                    }
+                }
+
+                elements.extend(fixes.map(RouteElement::NavAid));
             } else {
                 return Err(Error::UnexpectedRouteElement(element.to_string()));
             }
@@ -259,6 +313,56 @@ impl Route {
 }
 
 impl Route {
+    /// Expands the procedure `element` which is either the procedure ident or
+    /// the ident with the transition separated by a dot. Returns `None` if the
+    /// element is no procedure of the origin or the next airport within the
+    /// remaining `tokens`.
+    ///
+    /// Since the remaining tokens are scanned for the next airport, elements
+    /// are tried as procedure only after they failed to decode as anything
+    /// else.
+    fn expand_procedure(
+        element: &str,
+        elements: &[RouteElement],
+        mut tokens: std::str::SplitWhitespace,
+        nd: &NavigationData,
+    ) -> Option<Result<Vec<NavAid>, Error>> {
+        let (ident, transition) = match element.split_once('.') {
+            Some((ident, transition)) => (ident, Some(transition)),
+            None => (element, None),
+        };
+
+        let origin = elements.iter().find_map(|element| match element {
+            RouteElement::NavAid(NavAid::Airport(aprt)) => Some(aprt),
+            _ => None,
+        });
+
+        if let Some(procedure) = origin
+            .and_then(|aprt| nd.procedure(aprt, ident))
+            .filter(|procedure| procedure.kind() == ProcedureKind::Departure)
+        {
+            let designator = elements.iter().find_map(|element| match element {
+                RouteElement::RunwayDesignator(designator) => Some(designator.as_str()),
+                _ => None,
+            });
+
+            return Some(nd.procedure_fixes(procedure, designator, transition));
+        }
+
+        while let Some(token) = tokens.next() {
+            if let Some(NavAid::Airport(aprt)) = nd.find(token) {
+                let procedure = nd
+                    .procedure(&aprt, ident)
+                    .filter(|procedure| procedure.kind() != ProcedureKind::Departure)?;
+                let designator = tokens.next().and_then(|token| token.strip_prefix("RWY"));
+
+                return Some(nd.procedure_fixes(procedure, designator, transition));
+            }
+        }
+
+        None
+    }
+
     /// Returns the runway from an airport if a designator is next to the
     /// airport element.
     // TODO: Return Result rather than Option.
@@ -0,0 +1,414 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+use time::OffsetDateTime;
+
+use super::Route;
+use crate::geom::constants::EARTH_MEAN_RADIUS;
+use crate::geom::Coordinate;
+use crate::measurements::{Duration, Length, LengthUnit, Speed};
+use crate::nd::Fix;
+
+/// The ground speed in m/s below which no time to go is estimated.
+const MIN_GS: f32 = 1.0;
+
+type Vector = [f32; 3];
+
+/// A leg as great circle between two unit vectors.
+#[derive(Clone, PartialEq, Debug)]
+struct Segment {
+    to: Vector,
+    /// The normal of the great circle's plane.
+    normal: Vector,
+    /// The normal of the plane through the end that is passed when the leg
+    /// is sequenced.
+    exit: Vector,
+    /// The angular length of the leg.
+    len: f32,
+}
+
+/// In-flight navigation state along a [`Route`].
+///
+/// The tracker is updated with each position and ground speed, e.g. of a GNSS
+/// fix. It keeps the active leg together with the cross-track error (XTE) and
+/// the distance to go (DTG) to the next fix and the destination. A leg is
+/// sequenced when the position passes the bisector of the turn to the next
+/// leg, or abeam the end of the last leg.
+///
+/// The legs are converted once into great circles on construction, thus an
+/// update takes constant time and doesn't allocate. The tracker doesn't borrow
+/// the route and needs to be rebuilt if the route changes.
+///
+/// # Examples
+///
+/// ```
+/// # use efb::geom::Coordinate;
+/// # use efb::measurements::Speed;
+/// # use efb::nd::Fix;
+/// # use efb::route::{Route, Tracker};
+/// # use time::OffsetDateTime;
+/// # fn track(route: &Route, position: Coordinate) {
+/// let mut tracker = Tracker::new(route);
+/// tracker.update(&position, Speed::kt(107.0), OffsetDateTime::now_utc());
+///
+/// if let Some(leg) = tracker.active().map(|i| &route.legs()[i]) {
+///     println!("{} XTE {} DTG {}", leg.to().ident(), tracker.xte(), tracker.dtg());
+/// }
+/// # }
+/// ```
+#[derive(Clone, PartialEq, Debug)]
+pub struct Tracker {
+    segments: Vec<Segment>,
+    /// The angular length of all legs after the leg at the index.
+    remaining: Vec<f32>,
+    active: usize,
+    passed: bool,
+    xte: f32,
+    dtg: f32,
+    gs: f32,
+    time: Option<OffsetDateTime>,
+}
+
+impl Tracker {
+    /// Creates a tracker with the first leg of the `route` active.
+    pub fn new(route: &Route) -> Self {
+        let mut segments: Vec<Segment> = route
+            .legs()
+            .iter()
+            .map(|leg| Segment::new(&leg.from().coordinate(), &leg.to().coordinate()))
+            .collect();
+
+        for i in 1..segments.len() {
+            let next = segments[i].clone();
+            segments[i - 1].turn(&next);
+        }
+
+        let mut remaining = vec![0.0; segments.len()];
+        for i in (1..segments.len()).rev() {
+            remaining[i - 1] = remaining[i] + segments[i].len;
+        }
+
+        let dtg = segments.first().map(|s| s.len).unwrap_or_default();
+
+        Self {
+            segments,
+            remaining,
+            active: 0,
+            passed: false,
+            xte: 0.0,
+            dtg,
+            gs: 0.0,
+            time: None,
+        }
+    }
+
+    /// Updates the state with the `position` and ground speed `gs` at the
+    /// `time` of the fix.
+    ///
+    /// Returns `true` if one or more legs were sequenced by the update.
+    pub fn update(&mut self, position: &Coordinate, gs: Speed, time: OffsetDateTime) -> bool {
+        self.gs = gs.to_si();
+        self.time = Some(time);
+
+        let Some(mut segment) = self.segments.get(self.active) else {
+            return false;
+        };
+
+        let p = vector(position);
+        let mut sequenced = false;
+
+        // sequence all legs whose end was passed, e.g. after a gap in the fixes
+        while !self.passed && dot(&p, &segment.exit) >= 0.0 {
+            sequenced = true;
+            match self.segments.get(self.active + 1) {
+                Some(next) => {
+                    self.active += 1;
+                    segment = next;
+                }
+                None => self.passed = true,
+            }
+        }
+
+        self.xte = -dot(&p, &segment.normal).clamp(-1.0, 1.0).asin();
+        self.dtg = angle(&p, &segment.to);
+
+        sequenced
+    }
+
+    /// Returns a tracker of the modified `route` that continues with the leg
+    /// to the fix of the active leg, e.g. after a direct-to or a change of
+    /// the route ahead.
+    ///
+    /// If the route holds the fix more than once, the leg closest to the
+    /// active one is taken. If it doesn't hold the fix anymore, the leg at
+    /// the same index stays active. Once the destination is passed, the
+    /// tracker of the modified route stays passed.
+    pub fn rebuild(&self, route: &Route) -> Self {
+        let mut tracker = Self::new(route);
+        if tracker.segments.is_empty() {
+            return tracker;
+        }
+
+        if self.passed {
+            tracker.active = tracker.segments.len() - 1;
+            tracker.passed = true;
+        } else if let Some(active) = self.segments.get(self.active) {
+            let leg = tracker
+                .segments
+                .iter()
+                .enumerate()
+                .filter(|(_, segment)| segment.to == active.to)
+                .min_by_key(|(i, _)| i.abs_diff(self.active))
+                .map(|(i, _)| i);
+
+            match leg {
+                // the distance to go to the same fix doesn't change
+                Some(i) => {
+                    tracker.activate(i);
+                    tracker.dtg = self.dtg;
+                }
+                None if self.active < tracker.segments.len() => tracker.activate(self.active),
+                None => {}
+            }
+        }
+
+        tracker.gs = self.gs;
+        tracker.time = self.time;
+        tracker
+    }
+
+    /// Activates the leg at the `index` of the route's legs, e.g. to fly
+    /// direct to a fix or to skip a leg.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the `index` is out of the route's legs.
+    pub fn activate(&mut self, index: usize) {
+        assert!(index < self.segments.len(), "leg should be in the route");
+        self.active = index;
+        self.passed = false;
+        self.dtg = self.segments[index].len;
+        self.xte = 0.0;
+    }
+
+    /// Returns the index of the active leg in the route's legs.
+    ///
+    /// `None` is returned if the route has no legs or the destination was
+    /// passed.
+    pub fn active(&self) -> Option<usize> {
+        (!self.passed && self.active < self.segments.len()).then_some(self.active)
+    }
+
+    /// Returns `true` if the end of the last leg was passed.
+    pub fn is_passed(&self) -> bool {
+        self.passed
+    }
+
+    /// The cross-track error from the active leg, which is positive if the
+    /// position is right of the track.
+    pub fn xte(&self) -> Length {
+        nm(self.xte)
+    }
+
+    /// The distance to go to the next fix.
+    pub fn dtg(&self) -> Length {
+        nm(self.dtg)
+    }
+
+    /// The distance to go to the destination via the remaining legs.
+    pub fn dtg_destination(&self) -> Length {
+        nm(self.dtg + self.remaining.get(self.active).copied().unwrap_or_default())
+    }
+
+    /// The estimated time enroute to the next fix at the current ground
+    /// speed.
+    pub fn ete(&self) -> Option<Duration> {
+        self.ete_for(self.dtg())
+    }
+
+    /// The estimated time enroute to the destination at the current ground
+    /// speed.
+    pub fn ete_destination(&self) -> Option<Duration> {
+        self.ete_for(self.dtg_destination())
+    }
+
+    /// The estimated time of arrival (ETA) at the next fix.
+    pub fn eta(&self) -> Option<OffsetDateTime> {
+        self.eta_for(self.ete())
+    }
+
+    /// The estimated time of arrival (ETA) at the destination.
+    pub fn eta_destination(&self) -> Option<OffsetDateTime> {
+        self.eta_for(self.ete_destination())
+    }
+
+    fn ete_for(&self, dist: Length) -> Option<Duration> {
+        (self.gs >= MIN_GS).then(|| dist / Speed::mps(self.gs))
+    }
+
+    fn eta_for(&self, ete: Option<Duration>) -> Option<OffsetDateTime> {
+        Some(self.time? + time::Duration::seconds(ete?.to_si() as i64))
+    }
+}
+
+impl Segment {
+    fn new(from: &Coordinate, to: &Coordinate) -> Self {
+        let (from, to) = (vector(from), vector(to));
+        let normal = normalize(cross(&from, &to));
+
+        Self {
+            to,
+            normal,
+            // the direction of the track at the end
+            exit: cross(&normal, &to),
+            len: angle(&from, &to),
+        }
+    }
+
+    /// Sets the exit to the bisector of the turn onto the `next` leg. The
+    /// exit is kept for a reversal in which the bisector is the track itself.
+    fn turn(&mut self, next: &Segment) {
+        let outbound = cross(&next.normal, &self.to);
+        let sum = [
+            self.exit[0] + outbound[0],
+            self.exit[1] + outbound[1],
+            self.exit[2] + outbound[2],
+        ];
+
+        if dot(&sum, &sum) > 1e-6 {
+            self.exit = normalize(sum);
+        }
+    }
+}
+
+fn nm(angle: f32) -> Length {
+    Length::m(angle * EARTH_MEAN_RADIUS * 1000.0).convert_to(LengthUnit::NauticalMiles)
+}
+
+fn vector(coord: &Coordinate) -> Vector {
+    let (lat, lon) = (coord.latitude.to_radians(), coord.longitude.to_radians());
+    [lat.cos() * lon.cos(), lat.cos() * lon.sin(), lat.sin()]
+}
+
+fn dot(a: &Vector, b: &Vector) -> f32 {
+    a[0] * b[0] + a[1] * b[1] + a[2] * b[2]
+}
+
+fn cross(a: &Vector, b: &Vector) -> Vector {
+    [
+        a[1] * b[2] - a[2] * b[1],
+        a[2] * b[0] - a[0] * b[2],
+        a[0] * b[1] - a[1] * b[0],
+    ]
+}
+
+fn normalize(v: Vector) -> Vector {
+    let len = dot(&v, &v).sqrt();
+    if len > 0.0 {
+        [v[0] / len, v[1] / len, v[2] / len]
+    } else {
+        v
+    }
+}
+
+/// Returns the angle between the unit vectors `a` and `b`.
+fn angle(a: &Vector, b: &Vector) -> f32 {
+    let c = cross(a, b);
+    dot(&c, &c).sqrt().atan2(dot(a, b))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::fixtures;
+
+    #[test]
+    fn tracks_and_sequences_legs() {
+        let route = fixtures::route("EDDH ABBEN UL126 DELTA EDHF");
+        let mut tracker = Tracker::new(&route);
+        let now = OffsetDateTime::UNIX_EPOCH;
+
+        // east of the leg from ABBEN to BASUM which is flown south-west
+        tracker.activate(1);
+        let sequenced = tracker.update(&Coordinate::new(53.1667, 9.35), Speed::kt(100.0), now);
+        assert!(!sequenced);
+        assert_eq!(tracker.active(), Some(1));
+        assert!(*tracker.xte().value() < -2.0);
+        assert!(tracker.dtg().value() < route.legs()[1].dist().value());
+
+        // between BASUM and CELLE
+        let sequenced = tracker.update(&Coordinate::new(52.6667, 9.1667), Speed::kt(100.0), now);
+        assert!(sequenced);
+        assert_eq!(tracker.active(), Some(2));
+        assert!(tracker.xte().value().abs() < 0.1);
+
+        let remaining = route.legs()[3].dist().value() + route.legs()[4].dist().value();
+        let dtg = *tracker.dtg().value();
+        assert_eq!(
+            tracker.dtg_destination().value().round(),
+            (dtg + remaining).round()
+        );
+        assert_eq!(
+            tracker.ete().map(|ete| ete.to_si()),
+            Some((dtg / 100.0 * 3600.0).round() as u32)
+        );
+        assert_eq!(
+            tracker.eta(),
+            tracker
+                .ete()
+                .map(|ete| now + time::Duration::seconds(ete.to_si() as i64))
+        );
+
+        // beyond the destination
+        tracker.activate(4);
+        assert!(tracker.update(&Coordinate::new(54.5, 9.8), Speed::kt(100.0), now));
+        assert!(tracker.is_passed());
+        assert_eq!(tracker.active(), None);
+    }
+
+    #[test]
+    fn rebuilds_for_modified_route() {
+        let route = fixtures::route("EDDH ABBEN UL126 DELTA EDHF");
+        let mut tracker = Tracker::new(&route);
+        let now = OffsetDateTime::UNIX_EPOCH;
+
+        // between BASUM and CELLE
+        tracker.activate(2);
+        tracker.update(&Coordinate::new(52.6667, 9.1667), Speed::kt(100.0), now);
+
+        // the legs before the active one are dropped
+        let direct = fixtures::route("BASUM CELLE DELTA EDHF");
+        let rebuilt = tracker.rebuild(&direct);
+        assert_eq!(rebuilt.active(), Some(0));
+        assert_eq!(direct.legs()[0].to().ident(), "CELLE");
+
+        // the fix moved to a later leg
+        let detour = fixtures::route("EDDH EDHF ABBEN BASUM CELLE DELTA");
+        let rebuilt = tracker.rebuild(&detour);
+        assert_eq!(
+            rebuilt.active().map(|i| detour.legs()[i].to().ident()),
+            Some(String::from("CELLE"))
+        );
+        assert_eq!(rebuilt.dtg(), tracker.dtg());
+        assert_eq!(rebuilt.ete(), tracker.ete());
+
+        // tracking doesn't restart once the destination is passed
+        tracker.activate(4);
+        tracker.update(&Coordinate::new(54.5, 9.8), Speed::kt(100.0), now);
+        let rebuilt = tracker.rebuild(&route);
+        assert!(rebuilt.is_passed());
+        assert_eq!(rebuilt.active(), None);
+    }
+}
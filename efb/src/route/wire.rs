@@ -0,0 +1,458 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Joe Pearson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Compact binary wire format of a route.
+//!
+//! The format encodes the route's elements rather than its legs, since the
+//! legs are computed from the elements once the route is decoded. Navigation
+//! aids are referred to by their ident and location, thus a payload holds
+//! only a few bytes per fix and is resolved against the navigation data on
+//! the receiving side. All numbers are little-endian and measurements are
+//! packed as `f32` in their SI unit together with the unit to restore.
+//!
+//! ```text
+//! header    := "EFB" version:u8
+//! element   := tag:u8 payload
+//! speed     := unit:u8 value:f32
+//! level     := kind:u8 [value:u16|i16]
+//! wind      := unit:u8 direction:f32 speed
+//! navaid    := kind:u8 location:[u8; 2] len:u8 ident:[u8; len]
+//! runway    := len:u8 designator:[u8; len]
+//! ```
+
+use std::str;
+
+use crate::error::Error;
+use crate::measurements::{Angle, AngleUnit, Speed, SpeedUnit};
+use crate::nd::{Fix, LocationIndicator, NavAid, NavigationData};
+use crate::{VerticalDistance, Wind};
+
+use super::{Route, RouteElement};
+
+const MAGIC: &[u8; 3] = b"EFB";
+const VERSION: u8 = 1;
+
+const SPEED: u8 = 1;
+const LEVEL: u8 = 2;
+const WIND: u8 = 3;
+const NAVAID: u8 = 4;
+const RUNWAY: u8 = 5;
+const ALTERNATE: u8 = 6;
+
+/// The kind of navigation aid referred to by a [`WireElement`].
+#[derive(Copy, Clone, Eq, PartialEq, Debug)]
+pub enum WireNavAid {
+    Airport,
+    Waypoint,
+}
+
+/// An element of an encoded route that borrows its idents from the payload.
+#[derive(Copy, Clone, PartialEq, Debug)]
+pub enum WireElement<'a> {
+    Speed(Speed),
+    Level(VerticalDistance),
+    Wind(Wind),
+    NavAid {
+        kind: WireNavAid,
+        ident: &'a str,
+        location: Option<LocationIndicator>,
+    },
+    RunwayDesignator(&'a str),
+    Alternate {
+        kind: WireNavAid,
+        ident: &'a str,
+        location: Option<LocationIndicator>,
+    },
+}
+
+/// Reads the elements of an encoded route without copying the payload.
+///
+/// The reader is an iterator that yields each element or an
+/// [`UnexpectedWireFormat`] error if the payload is truncated or malformed,
+/// after which no further elements are read.
+///
+/// [`UnexpectedWireFormat`]: Error::UnexpectedWireFormat
+pub struct WireReader<'a> {
+    bytes: &'a [u8],
+}
+
+impl<'a> WireReader<'a> {
+    /// Creates a reader over the `bytes` after checking the header.
+    pub fn new(bytes: &'a [u8]) -> Result<Self, Error> {
+        match bytes {
+            [m0, m1, m2, VERSION, rest @ ..] if [*m0, *m1, *m2] == *MAGIC => {
+                Ok(Self { bytes: rest })
+            }
+            _ => Err(Error::UnexpectedWireFormat),
+        }
+    }
+
+    fn take(&mut self, n: usize) -> Result<&'a [u8], Error> {
+        if self.bytes.len() < n {
+            return Err(Error::UnexpectedWireFormat);
+        }
+        let (head, tail) = self.bytes.split_at(n);
+        self.bytes = tail;
+        Ok(head)
+    }
+
+    fn u8(&mut self) -> Result<u8, Error> {
+        self.take(1).map(|b| b[0])
+    }
+
+    fn u16(&mut self) -> Result<u16, Error> {
+        self.take(2).map(|b| u16::from_le_bytes([b[0], b[1]]))
+    }
+
+    fn f32(&mut self) -> Result<f32, Error> {
+        self.take(4)
+            .map(|b| f32::from_le_bytes([b[0], b[1], b[2], b[3]]))
+    }
+
+    fn str(&mut self) -> Result<&'a str, Error> {
+        let len = self.u8()? as usize;
+        str::from_utf8(self.take(len)?).map_err(|_| Error::UnexpectedWireFormat)
+    }
+
+    fn speed(&mut self) -> Result<Speed, Error> {
+        let unit = match self.u8()? {
+            0 => SpeedUnit::MetersPerSecond,
+            1 => SpeedUnit::Knots,
+            2 => SpeedUnit::Mach,
+            _ => return Err(Error::UnexpectedWireFormat),
+        };
+        let value = self.f32()?;
+
+        // the Mach number has no SI conversion and is packed as is
+        Ok(match unit {
+            SpeedUnit::Mach => Speed::new(value, unit),
+            _ => Speed::from_si(value, unit),
+        })
+    }
+
+    fn level(&mut self) -> Result<VerticalDistance, Error> {
+        Ok(match self.u8()? {
+            0 => VerticalDistance::Agl(self.u16()?),
+            1 => VerticalDistance::Altitude(self.u16()?),
+            2 => VerticalDistance::PressureAltitude(self.u16()? as i16),
+            3 => VerticalDistance::Fl(self.u16()?),
+            4 => VerticalDistance::Gnd,
+            5 => VerticalDistance::Msl(self.u16()?),
+            6 => VerticalDistance::Unlimited,
+            _ => return Err(Error::UnexpectedWireFormat),
+        })
+    }
+
+    fn wind(&mut self) -> Result<Wind, Error> {
+        let unit = match self.u8()? {
+            0 => AngleUnit::TrueNorth,
+            1 => AngleUnit::MagneticNorth,
+            2 => AngleUnit::Radian,
+            _ => return Err(Error::UnexpectedWireFormat),
+        };
+        let direction = Angle::from_si(self.f32()?, unit);
+
+        Ok(Wind {
+            direction,
+            speed: self.speed()?,
+        })
+    }
+
+    fn navaid(&mut self) -> Result<(WireNavAid, &'a str, Option<LocationIndicator>), Error> {
+        let kind = match self.u8()? {
+            0 => WireNavAid::Airport,
+            1 => WireNavAid::Waypoint,
+            _ => return Err(Error::UnexpectedWireFormat),
+        };
+        let location = match self.take(2)? {
+            [0, 0] => None,
+            code => Some(
+                str::from_utf8(code)
+                    .ok()
+                    .and_then(|code| LocationIndicator::new(code).ok())
+                    .ok_or(Error::UnexpectedWireFormat)?,
+            ),
+        };
+
+        Ok((kind, self.str()?, location))
+    }
+
+    fn element(&mut self) -> Result<WireElement<'a>, Error> {
+        Ok(match self.u8()? {
+            SPEED => WireElement::Speed(self.speed()?),
+            LEVEL => WireElement::Level(self.level()?),
+            WIND => WireElement::Wind(self.wind()?),
+            NAVAID => {
+                let (kind, ident, location) = self.navaid()?;
+                WireElement::NavAid {
+                    kind,
+                    ident,
+                    location,
+                }
+            }
+            RUNWAY => WireElement::RunwayDesignator(self.str()?),
+            ALTERNATE => {
+                let (kind, ident, location) = self.navaid()?;
+                WireElement::Alternate {
+                    kind,
+                    ident,
+                    location,
+                }
+            }
+            _ => return Err(Error::UnexpectedWireFormat),
+        })
+    }
+}
+
+impl<'a> Iterator for WireReader<'a> {
+    type Item = Result<WireElement<'a>, Error>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        if self.bytes.is_empty() {
+            return None;
+        }
+
+        let element = self.element();
+        if element.is_err() {
+            self.bytes = &[];
+        }
+
+        Some(element)
+    }
+}
+
+impl Route {
+    /// Encodes the route into the compact wire format.
+    ///
+    /// Idents longer than 255 bytes can't be encoded and are truncated, which
+    /// doesn't occur with ARINC 424 or OpenAir data.
+    pub fn to_wire(&self) -> Vec<u8> {
+        // most elements are fixes with an ident of up to five characters
+        let mut buffer = Vec::with_capacity(4 + self.elements.len() * 10);
+        buffer.extend_from_slice(MAGIC);
+        buffer.push(VERSION);
+
+        for element in &self.elements {
+            match element {
+                RouteElement::Speed(speed) => {
+                    buffer.push(SPEED);
+                    put_speed(&mut buffer, speed);
+                }
+                RouteElement::Level(level) => {
+                    buffer.push(LEVEL);
+                    put_level(&mut buffer, level);
+                }
+                RouteElement::Wind(wind) => {
+                    buffer.push(WIND);
+                    buffer.push(match wind.direction.unit() {
+                        AngleUnit::TrueNorth => 0,
+                        AngleUnit::MagneticNorth => 1,
+                        AngleUnit::Radian => 2,
+                    });
+                    buffer.extend_from_slice(&wind.direction.to_si().to_le_bytes());
+                    put_speed(&mut buffer, &wind.speed);
+                }
+                RouteElement::NavAid(navaid) => {
+                    buffer.push(NAVAID);
+                    put_navaid(&mut buffer, navaid);
+                }
+                RouteElement::RunwayDesignator(designator) => {
+                    buffer.push(RUNWAY);
+                    put_str(&mut buffer, designator);
+                }
+            }
+        }
+
+        if let Some(alternate) = &self.alternate {
+            buffer.push(ALTERNATE);
+            put_navaid(&mut buffer, alternate);
+        }
+
+        buffer
+    }
+
+    /// Decodes a route from the wire format and resolves its navigation aids
+    /// from the navigation data `nd`.
+    ///
+    /// # Errors
+    ///
+    /// Returns [`UnexpectedWireFormat`] if the `bytes` are malformed and
+    /// [`UnknownIdent`] if a navigation aid isn't found in `nd`.
+    ///
+    /// [`UnexpectedWireFormat`]: Error::UnexpectedWireFormat
+    /// [`UnknownIdent`]: Error::UnknownIdent
+    pub fn from_wire(bytes: &[u8], nd: &NavigationData) -> Result<Self, Error> {
+        let mut route = Route::new();
+        let mut elements = Vec::new();
+
+        for element in WireReader::new(bytes)? {
+            match element? {
+                WireElement::Speed(speed) => {
+                    route.speed.get_or_insert(speed);
+                    elements.push(RouteElement::Speed(speed));
+                }
+                WireElement::Level(level) => {
+                    route.level.get_or_insert(level);
+                    elements.push(RouteElement::Level(level));
+                }
+                WireElement::Wind(wind) => elements.push(RouteElement::Wind(wind)),
+                WireElement::NavAid {
+                    kind,
+                    ident,
+                    location,
+                } => elements.push(RouteElement::NavAid(resolve(nd, kind, ident, location)?)),
+                WireElement::RunwayDesignator(designator) => {
+                    elements.push(RouteElement::RunwayDesignator(designator.to_string()))
+                }
+                WireElement::Alternate {
+                    kind,
+                    ident,
+                    location,
+                } => route.alternate = Some(resolve(nd, kind, ident, location)?),
+            }
+        }
+
+        route.legs = Self::legs_from_elements(&elements);
+        route.elements = elements;
+
+        Ok(route)
+    }
+}
+
+fn resolve(
+    nd: &NavigationData,
+    kind: WireNavAid,
+    ident: &str,
+    location: Option<LocationIndicator>,
+) -> Result<NavAid, Error> {
+    let locations = location.as_ref().map(std::slice::from_ref);
+    let navaid = match kind {
+        WireNavAid::Airport => nd.find_airport(ident, locations),
+        WireNavAid::Waypoint => nd.find_waypoint(ident, locations),
+    };
+
+    navaid.ok_or_else(|| Error::UnknownIdent(ident.to_string()))
+}
+
+fn put_str(buffer: &mut Vec<u8>, s: &str) {
+    let mut len = s.len().min(u8::MAX as usize);
+    while !s.is_char_boundary(len) {
+        len -= 1;
+    }
+    buffer.push(len as u8);
+    buffer.extend_from_slice(&s.as_bytes()[..len]);
+}
+
+fn put_speed(buffer: &mut Vec<u8>, speed: &Speed) {
+    let (unit, value) = match speed.unit() {
+        SpeedUnit::MetersPerSecond => (0, speed.to_si()),
+        SpeedUnit::Knots => (1, speed.to_si()),
+        SpeedUnit::Mach => (2, *speed.value()),
+    };
+    buffer.push(unit);
+    buffer.extend_from_slice(&value.to_le_bytes());
+}
+
+fn put_level(buffer: &mut Vec<u8>, level: &VerticalDistance) {
+    let (kind, value) = match *level {
+        VerticalDistance::Agl(value) => (0, Some(value)),
+        VerticalDistance::Altitude(value) => (1, Some(value)),
+        VerticalDistance::PressureAltitude(value) => (2, Some(value as u16)),
+        VerticalDistance::Fl(value) => (3, Some(value)),
+        VerticalDistance::Gnd => (4, None),
+        VerticalDistance::Msl(value) => (5, Some(value)),
+        VerticalDistance::Unlimited => (6, None),
+    };
+    buffer.push(kind);
+    if let Some(value) = value {
+        buffer.extend_from_slice(&value.to_le_bytes());
+    }
+}
+
+fn put_navaid(buffer: &mut Vec<u8>, navaid: &NavAid) {
+    buffer.push(match navaid {
+        NavAid::Airport(_) => 0,
+        NavAid::Waypoint(_) => 1,
+    });
+    match navaid.location() {
+        Some(location) => buffer.extend_from_slice(location.as_str().as_bytes()),
+        None => buffer.extend_from_slice(&[0, 0]),
+    }
+    put_str(buffer, &navaid.ident());
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::fixtures;
+
+    #[test]
+    fn round_trips_wire_format() {
+        let nd = fixtures::nd();
+        let mut route = Route::new();
+        route
+            .decode("13509KT N0107 A025 EDDH RWY33 DHN2 DHN1 EDHF RWY20", &nd)
+            .expect("route should decode");
+        route.set_alternate(nd.find("EDDH"));
+
+        let bytes = route.to_wire();
+        let decoded = Route::from_wire(&bytes, &nd).expect("wire format should decode");
+
+        assert_eq!(decoded.elements().len(), route.elements().len());
+        assert_eq!(decoded.level(), route.level());
+        assert_eq!(decoded.landing_rwy(), route.landing_rwy());
+        assert_eq!(
+            decoded.speed().map(|speed| speed.value().round()),
+            Some(107.0)
+        );
+        assert_eq!(
+            decoded.alternate().map(|leg| leg.to().ident()),
+            Some(String::from("EDDH"))
+        );
+
+        for (decoded, leg) in decoded.legs().iter().zip(route.legs()) {
+            assert_eq!(decoded.to(), leg.to());
+            assert_eq!(
+                decoded.heading().map(|h| h.value().round()),
+                leg.heading().map(|h| h.value().round())
+            );
+        }
+
+        assert_eq!(
+            Route::from_wire(&bytes[..bytes.len() - 1], &nd),
+            Err(Error::UnexpectedWireFormat)
+        );
+    }
+
+    #[test]
+    fn resolves_airport_shadowed_by_waypoint() {
+        let mut route = Route::new();
+        route
+            .decode("13509KT N0107 A025 EDDH DHN1 EDHF", &fixtures::nd())
+            .expect("route should decode");
+
+        // a waypoint with the ident of the destination is preferred by find
+        let edhf = "SEUREAENRTED EDHF  ED0    C   B N53000000E009000000                                 WGE           EDHF                     000012509";
+        let mut nd = fixtures::nd();
+        nd.append(NavigationData::try_from_arinc424(edhf).expect("records should be valid"));
+        assert!(matches!(nd.find("EDHF"), Some(NavAid::Waypoint(_))));
+
+        let decoded = Route::from_wire(&route.to_wire(), &nd).expect("wire format should decode");
+        assert!(matches!(
+            decoded.legs().last().map(|leg| leg.to()),
+            Some(NavAid::Airport(_))
+        ));
+    }
+}
@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+use efb::error::Error;
 use efb::nd::{Fix, NavigationData};
 use efb::route::Route;
 
@@ -26,6 +27,50 @@ SEURP EDHFEDGRW20    0034122060 N53594752E009344856                          098
 
 const ROUTE: &'static str = r#"EDDH RWY33 DHN2 DHN1 EDHF RWY20"#;
 
+const AIRWAY_RECORDS: &'static str = r#"SEUREAENRTED ABBEN ED0    C   B N53300000E009300000                                 WGE           ABBEN                    000012509
+SEUREAENRTED BASUM ED0    C   B N52500000E009000000                                 WGE           BASUM                    000022509
+SEUREAENRTED CELLE ED0    C   B N52300000E009200000                                 WGE           CELLE                    000032509
+SEUREAENRTED DELTA ED0    C   B N52000000E008400000                                 WGE           DELTA                    000042509
+SEURER       UL126       0010ABBENEDEA0     OH                                                                             000052509
+SEURER       UL126       0020BASUMEDEA0     OH                                                                             000062509
+SEURER       UL126       0030CELLEEDEA0     OH                                                                             000072509
+SEURER       UL126       0040DELTAEDEA0     OH                                                                             000082509
+"#;
+
+const AREA_AIRWAY_RECORDS: &'static str = r#"SEURER       A1          0010ABBENEDEA0     OH                                                                             000092509
+SEURER       A1          0020BASUMEDEA0     OH                                                                             000102509
+SPACER       A1          0010CELLEEDEA0     OH                                                                             000112509
+SPACER       A1          0020DELTAEDEA0     OH                                                                             000122509
+"#;
+
+const PROCEDURE_RECORDS: &'static str = r#"SEURP EDDHEDDABBE1D1RW33  010         0        CA                                                                          000112509
+SEURP EDDHEDDABBE1D1RW33  020N2   EDPC0        DF                                                                          000122509
+SEURP EDDHEDDABBE1D2      010N1   EDPC0        TF                                                                          000132509
+SEURP EDDHEDDABBE1D3ABBEN 010N1   EDPC0        IF                                                                          000142509
+SEURP EDDHEDDABBE1D3ABBEN 020ABBENEDEA0        TF                                                                          000152509
+SEURP EDHFEDEDELT1H2      010CELLEEDEA0        IF                                                                          000162509
+SEURP EDHFEDEDELT1H2      020DELTAEDEA0        TF                                                                          000172509
+"#;
+
+fn airway_route(s: &str) -> Result<Route, Error> {
+    let mut nd =
+        NavigationData::try_from_arinc424(ARINC_424_RECORDS).expect("records should be valid");
+    nd.append(NavigationData::try_from_arinc424(AIRWAY_RECORDS).expect("records should be valid"));
+
+    let mut route = Route::new();
+    route.decode(s, &nd)?;
+    Ok(route)
+}
+
+fn procedure_route(s: &str) -> Result<Route, Error> {
+    let records = format!("{ARINC_424_RECORDS}{AIRWAY_RECORDS}{PROCEDURE_RECORDS}");
+    let nd = NavigationData::try_from_arinc424(&records).expect("records should be valid");
+
+    let mut route = Route::new();
+    route.decode(s, &nd)?;
+    Ok(route)
+}
+
 fn route() -> Route {
     let nd = NavigationData::try_from_arinc424(ARINC_424_RECORDS).expect("records should be valid");
     let mut route = Route::new();
@@ -97,3 +142,79 @@ fn accumulate_legs() {
         30.0
     );
 }
+
+#[test]
+fn expands_airway() {
+    let route = airway_route("EDDH ABBEN UL126 DELTA EDHF").expect("route should decode");
+    let idents: Vec<String> = route.legs().iter().map(|leg| leg.to().ident()).collect();
+    assert_eq!(idents, vec!["ABBEN", "BASUM", "CELLE", "DELTA", "EDHF"]);
+}
+
+#[test]
+fn expands_airway_in_reverse() {
+    let route = airway_route("EDHF DELTA UL126 BASUM EDDH").expect("route should decode");
+    let idents: Vec<String> = route.legs().iter().map(|leg| leg.to().ident()).collect();
+    assert_eq!(idents, vec!["DELTA", "CELLE", "BASUM", "EDDH"]);
+}
+
+#[test]
+fn rejects_fix_not_on_airway() {
+    assert_eq!(
+        airway_route("EDDH ABBEN UL126 EDHF"),
+        Err(Error::UnknownAirwaySegment {
+            airway: String::from("UL126"),
+            from: String::from("ABBEN"),
+            to: String::from("EDHF"),
+        })
+    );
+}
+
+#[test]
+fn expands_procedures() {
+    let route = procedure_route("EDDH RWY33 ABBE1D.ABBEN UL126 CELLE DELT1H EDHF RWY20")
+        .expect("route should decode");
+    let idents: Vec<String> = route.legs().iter().map(|leg| leg.to().ident()).collect();
+    assert_eq!(
+        idents,
+        vec!["DHN2", "DHN1", "ABBEN", "BASUM", "CELLE", "DELTA", "EDHF"]
+    );
+}
+
+#[test]
+fn rejects_unknown_transition() {
+    assert_eq!(
+        procedure_route("EDDH RWY33 ABBE1D.XYZ EDHF"),
+        Err(Error::UnknownTransition {
+            procedure: String::from("ABBE1D"),
+            transition: String::from("XYZ"),
+        })
+    );
+}
+
+#[test]
+fn keeps_airways_of_areas_apart() {
+    let records = format!("{ARINC_424_RECORDS}{AIRWAY_RECORDS}{AREA_AIRWAY_RECORDS}");
+    let nd = NavigationData::try_from_arinc424(&records).expect("records should be valid");
+    let decode = |s: &str| {
+        let mut route = Route::new();
+        route.decode(s, &nd).map(|_| route)
+    };
+
+    let route = decode("EDDH ABBEN A1 BASUM EDHF").expect("route should decode");
+    let idents: Vec<String> = route.legs().iter().map(|leg| leg.to().ident()).collect();
+    assert_eq!(idents, vec!["ABBEN", "BASUM", "EDHF"]);
+
+    let route = decode("EDDH CELLE A1 DELTA EDHF").expect("route should decode");
+    let idents: Vec<String> = route.legs().iter().map(|leg| leg.to().ident()).collect();
+    assert_eq!(idents, vec!["CELLE", "DELTA", "EDHF"]);
+
+    // the A1 of both areas aren't connected
+    assert_eq!(
+        decode("EDDH ABBEN A1 DELTA EDHF").err(),
+        Some(Error::UnknownAirwaySegment {
+            airway: String::from("A1"),
+            from: String::from("ABBEN"),
+            to: String::from("DELTA"),
+        })
+    );
+}